@@ -0,0 +1,54 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/Future.h>
+#include <thousandeyes/futures/async.h>
+
+using namespace std;
+using namespace std::chrono;
+using namespace thousandeyes::futures;
+
+int main(int argc, const char* argv[])
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+
+    // The work runs on the executor's threads and the continuations are
+    // invoked as soon as it completes, without any polling
+    vector<Future<string>> futures;
+    for (int i = 0; i < 100; ++i) {
+        auto f = thousandeyes::futures::async(executor, [i]() {
+            this_thread::sleep_for(milliseconds(10));
+            return i;
+        });
+
+        futures.push_back(then(std::move(f), [](Future<int> f) {
+            return to_string(f.get());
+        }));
+    }
+
+    auto results = all(std::move(futures)).get();
+
+    string result;
+    for (auto& f: results) {
+        result += f.get() + " ";
+    }
+
+    cout << "Got result: " << result << endl;
+
+    executor->stop();
+}
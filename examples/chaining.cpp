@@ -8,6 +8,7 @@
  * @author Giannis Georgalis, https://github.com/ggeorgalis
  */
 
+#include <fstream>
 #include <functional>
 #include <future>
 #include <iostream>
@@ -15,6 +16,7 @@
 #include <memory>
 
 #include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/Tracer.h>
 #include <thousandeyes/futures/then.h>
 
 using namespace std;
@@ -38,6 +40,10 @@ int main(int argc, const char* argv[])
     auto executor = make_shared<DefaultExecutor>(milliseconds(10));
     Default<Executor>::Setter execSetter(executor);
 
+    // Records the chain if compiled with THOUSANDEYES_FUTURES_TRACING
+    auto tracer = make_shared<Tracer>();
+    executor->setTracer(tracer);
+
     auto f = then(getValueAsync(1821), [](future<int> f) {
         auto first = to_string(f.get());
         return then(getValueAsync(string("1822")), [first](future<string> f) {
@@ -53,4 +59,9 @@ int main(int argc, const char* argv[])
     cout << "Got result: " << result << endl;
 
     executor->stop();
+
+    if (argc > 1) {
+        ofstream trace(argv[1]);
+        tracer->writeChromeTrace(trace);
+    }
 }
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/then.h>
+
+using namespace std;
+using namespace std::chrono;
+using namespace thousandeyes::futures;
+
+namespace {
+
+double toMilliseconds(steady_clock::duration d)
+{
+    return duration_cast<microseconds>(d).count() / 1000.0;
+}
+
+// Measures the executor with the given number of watched futures: the time to
+// watch them, the time for a single sweep over them while none of them is ready
+// and the time to dispatch all of them once they become ready
+void benchmark(size_t count)
+{
+    // The executor polls without blocking, so that the measurements do not
+    // depend on the polling timeout
+    auto executor = make_shared<DefaultExecutor>(microseconds(0));
+
+    atomic<size_t> remaining(count);
+    promise<void> done;
+
+    vector<promise<void>> promises(count);
+    vector<future<void>> results;
+    results.reserve(count);
+
+    auto t0 = steady_clock::now();
+
+    for (auto& p: promises) {
+        results.push_back(then(executor, p.get_future(), [&remaining, &done](future<void>) {
+            if (--remaining == 0) {
+                done.set_value();
+            }
+        }));
+    }
+
+    auto t1 = steady_clock::now();
+
+    // A ready future is watched after all the others, so it is only found ready
+    // after the executor sweeps over the rest
+    promise<void> probe;
+    probe.set_value();
+
+    then(executor, probe.get_future(), [](future<void>) {}).get();
+
+    auto t2 = steady_clock::now();
+
+    for (auto& p: promises) {
+        p.set_value();
+    }
+
+    done.get_future().get();
+
+    auto t3 = steady_clock::now();
+
+    cout << count << " futures: "
+         << "watch " << toMilliseconds(t1 - t0) << " ms, "
+         << "sweep " << toMilliseconds(t2 - t1) << " ms, "
+         << "dispatch " << toMilliseconds(t3 - t2) << " ms" << endl;
+
+    executor->stop();
+}
+
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            benchmark(strtoul(argv[i], nullptr, 10));
+        }
+
+        return 0;
+    }
+
+    for (size_t count: { 10000, 100000, 1000000 }) {
+        benchmark(count);
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/PollingExecutorWithPartialSort.h>
+#include <thousandeyes/futures/then.h>
+
+using namespace std;
+using namespace std::chrono;
+using namespace thousandeyes::futures;
+
+// Measures the time it takes to stop an executor with many pending futures
+
+namespace {
+
+using PartialSortExecutor = PollingExecutorWithPartialSort<
+    detail::InvokerWithNewThread,
+    detail::InvokerWithSingleThread
+>;
+
+template<class TExecutor>
+void benchmark(const string& name, size_t count)
+{
+    auto executor = make_shared<TExecutor>(milliseconds(10));
+
+    vector<promise<int>> promises(count);
+    vector<future<int>> results;
+    results.reserve(count);
+
+    for (auto& p: promises) {
+        results.push_back(then(executor, p.get_future(), [](future<int> f) {
+            return f.get();
+        }));
+    }
+
+    auto t0 = steady_clock::now();
+
+    executor->stop();
+
+    auto t1 = steady_clock::now();
+
+    size_t cancelled = 0;
+    for (auto& f: results) {
+        try {
+            f.get();
+        }
+        catch (const WaitableWaitException&) {
+            ++cancelled;
+        }
+    }
+
+    auto t2 = steady_clock::now();
+
+    cout << name << ": stop() took " << duration_cast<microseconds>(t1 - t0).count()
+         << "us, all " << cancelled << " futures were cancelled after "
+         << duration_cast<microseconds>(t2 - t0).count() << "us" << endl;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+    size_t count = 100000;
+
+    if (argc >= 2) {
+        count = stoul(argv[1]);
+    }
+
+    benchmark<DefaultExecutor>("DefaultExecutor", count);
+    benchmark<PartialSortExecutor>("PollingExecutorWithPartialSort", count);
+
+    return 0;
+}
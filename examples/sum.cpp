@@ -17,6 +17,7 @@
 
 #include <thousandeyes/futures/DefaultExecutor.h>
 #include <thousandeyes/futures/all.h>
+#include <thousandeyes/futures/reduce.h>
 #include <thousandeyes/futures/then.h>
 
 using namespace std;
@@ -57,5 +58,17 @@ int main(int argc, const char* argv[])
 
     cout << "Got result: " << result << endl;
 
+    // Folds each value as soon as it is ready, instead of keeping all of them
+    // until the last one is ready
+    for (int i = 0; i < 1821; ++i) {
+        futures.push_back(getValueAsync(i));
+    }
+
+    auto g = reduce(move(futures), 0, [](int sum, int value) {
+        return sum + value;
+    });
+
+    cout << "Got reduced result: " << g.get() << endl;
+
     executor->stop();
 }
@@ -19,6 +19,7 @@
 #include <thousandeyes/futures/DefaultExecutor.h>
 #include <thousandeyes/futures/all.h>
 #include <thousandeyes/futures/then.h>
+#include <thousandeyes/futures/timer.h>
 
 using namespace std;
 using namespace std::chrono;
@@ -29,16 +30,11 @@ namespace {
 template<class T>
 future<T> getValueAfter(const T& value, const milliseconds& t)
 {
-    promise<T> p;
-    auto result = p.get_future();
-
-    // Note: ~std::future of futures returned by std::async() may block until ready
-    thread([p=move(p), value, t]() mutable {
-        this_thread::sleep_for(t);
-        p.set_value_at_thread_exit(value);
-    }).detach();
-
-    return result;
+    // The timer is served by the default executor, without spawning a thread
+    return then(after(t), [value](future<void> f) {
+        f.get();
+        return value;
+    });
 }
 
 } // namespace
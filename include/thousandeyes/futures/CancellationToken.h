@@ -0,0 +1,96 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace thousandeyes {
+namespace futures {
+
+//! \brief A cheap, copyable handle that reports whether the associated
+//! #CancellationSource has been cancelled.
+//!
+//! \note A default-constructed token is never cancelled.
+//!
+//! \sa CancellationSource
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    //! \brief Checks whether the associated #CancellationSource has been cancelled.
+    //!
+    //! \return true if cancellation was requested and false otherwise.
+    inline bool cancelled() const
+    {
+        return state_ && state_->load(std::memory_order_acquire);
+    }
+
+    //! \brief Checks whether the token can ever become cancelled.
+    //!
+    //! \return true if the token is associated with a #CancellationSource.
+    inline bool cancellable() const
+    {
+        return static_cast<bool>(state_);
+    }
+
+private:
+    friend class CancellationSource;
+
+    explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> state) :
+        state_(std::move(state))
+    {}
+
+    std::shared_ptr<const std::atomic<bool>> state_;
+};
+
+//! \brief The object used to request the cancellation of all the work
+//! associated with its tokens.
+//!
+//! \par Tokens obtained from a source can be passed to then() and all(), so that
+//! the executor drops the corresponding #Waitable objects as soon as cancel()
+//! is called, making the resulting futures ready with a #WaitableCancelledException.
+//!
+//! \sa CancellationToken
+class CancellationSource {
+public:
+    CancellationSource() :
+        state_(std::make_shared<std::atomic<bool>>(false))
+    {}
+
+    //! \brief Returns a token associated with the current source.
+    inline CancellationToken token() const
+    {
+        return CancellationToken(state_);
+    }
+
+    //! \brief Requests the cancellation of the work associated with the
+    //! source's tokens.
+    //!
+    //! \note Calling cancel() more than once has no additional effect.
+    inline void cancel()
+    {
+        state_->store(true, std::memory_order_release);
+    }
+
+    //! \brief Checks whether cancel() has been called.
+    inline bool cancelled() const
+    {
+        return state_->load(std::memory_order_acquire);
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> state_;
+};
+
+} // namespace futures
+} // namespace thousandeyes
@@ -18,6 +18,7 @@
 #include <thousandeyes/futures/PollingExecutor.h>
 #include <thousandeyes/futures/detail/InvokerWithNewThread.h>
 #include <thousandeyes/futures/detail/InvokerWithSingleThread.h>
+#include <thousandeyes/futures/detail/InvokerWithTimeBudget.h>
 
 namespace thousandeyes {
 namespace futures {
@@ -25,5 +26,13 @@ namespace futures {
 using DefaultExecutor = PollingExecutor<detail::InvokerWithNewThread,
                                         detail::InvokerWithSingleThread>;
 
+//! \brief A #PollingExecutor that runs cheap continuations directly on its polling
+//! thread and falls back to a dispatching thread while continuations exceed the
+//! time budget of its invoker (100us by default).
+using InlineDispatchExecutor = PollingExecutor<
+    detail::InvokerWithNewThread,
+    detail::InvokerWithTimeBudget<detail::InvokerWithSingleThread>
+>;
+
 } // namespace futures
 } // namespace thousandeyes
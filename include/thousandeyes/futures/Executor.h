@@ -10,17 +10,38 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <string>
 
-namespace thousandeyes {
-namespace futures {
-class Waitable;
-} // namespace futures
-} // namespace thousandeyes
+#include <thousandeyes/futures/Waitable.h>
 
 namespace thousandeyes {
 namespace futures {
 
+//! \brief Exception used for dispatching the #Waitable objects that an
+//! #Executor cannot accept because it is at its capacity.
+//!
+//! \sa OverflowPolicy
+class ExecutorOverflowException : public WaitableWaitException {
+public:
+    explicit ExecutorOverflowException(const std::string& error) :
+        WaitableWaitException(error)
+    {}
+};
+
+//! \brief The behavior of a bounded #Executor when a #Waitable is watched
+//! while the #Executor is at its capacity.
+enum class OverflowPolicy {
+    //! The caller of watch() blocks until there is enough capacity.
+    Block,
+    //! The given #Waitable is dispatched with an #ExecutorOverflowException.
+    Reject,
+    //! The oldest #Waitable is dispatched with an #ExecutorOverflowException
+    //! to make room for the given one.
+    ShedOldest
+};
+
 //! \brief Interface for the component that is responsible for eventually executing
 //! a #Waitable when it becomes ready.
 class Executor {
@@ -35,8 +56,52 @@ public:
     //! when it throws.
     virtual void watch(std::unique_ptr<Waitable> w) = 0;
 
+    //! \brief Watches the given #Waitable only if the executor can accept it
+    //! without blocking or dropping any other #Waitable.
+    //!
+    //! \param w The #Waitable instance to monitor and dispatch when ready.
+    //!
+    //! \return true if the executor took ownership of the #Waitable and false
+    //! if it was rejected, in which case w is left untouched.
+    virtual bool tryWatch(std::unique_ptr<Waitable>& w)
+    {
+        watch(std::move(w));
+        return true;
+    }
+
+    //! \brief Dispatches the given, already ready, #Waitable as soon as possible,
+    //! without polling it.
+    //!
+    //! \param w The #Waitable instance to dispatch.
+    //!
+    //! \note Executors with threads for running work, such as the #PollingExecutor,
+    //! dispatch the #Waitable on one of them. The default implementation just
+    //! watches the #Waitable.
+    //!
+    //! \sa async()
+    virtual void post(std::unique_ptr<Waitable> w)
+    {
+        watch(std::move(w));
+    }
+
     //! \brief Stops the executor and tries to cancel all pending operations.
     virtual void stop() = 0;
+
+    //! \brief Stops accepting new #Waitable objects and waits, at most until the
+    //! given deadline, for the pending ones to be dispatched before stopping.
+    //!
+    //! \param deadline The time after which the remaining #Waitable objects
+    //! are cancelled as in stop().
+    //!
+    //! \return true if all the pending #Waitable objects were dispatched before
+    //! the deadline and false otherwise.
+    //!
+    //! \note The default implementation does not wait and just calls stop().
+    virtual bool drain(std::chrono::steady_clock::time_point /* deadline */)
+    {
+        stop();
+        return false;
+    }
 };
 
 } // namespace futures
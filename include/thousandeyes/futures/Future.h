@@ -0,0 +1,552 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <thousandeyes/futures/detail/SharedState.h>
+
+#include <thousandeyes/futures/Default.h>
+#include <thousandeyes/futures/Executor.h>
+#include <thousandeyes/futures/TimedWaitable.h>
+
+namespace thousandeyes {
+namespace futures {
+
+template<class T>
+class Future;
+
+namespace detail {
+
+struct FutureAccess {
+    template<class T>
+    static Future<T> make(std::shared_ptr<SharedState<T>> state)
+    {
+        return Future<T>(std::move(state));
+    }
+
+    template<class T>
+    static const std::shared_ptr<SharedState<T>>& state(const Future<T>& f)
+    {
+        if (!f.state_) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+
+        return f.state_;
+    }
+};
+
+} // namespace detail
+
+//! \brief A future whose shared state is observed by the library without polling.
+//!
+//! \par Unlike std::future, the shared state of a Future is a single allocation
+//! that stores the value inline and synchronizes the value with, at most, one
+//! continuation through an atomic status. Continuations attached with then() or
+//! all() are invoked by the thread that makes the Future ready, so that they do
+//! not involve any #Executor.
+//!
+//! \note Blocking in get(), wait() or wait_for() does not occupy the continuation
+//! slot of the shared state, so it never conflicts with a continuation. Since then()
+//! and all() consume the Future, however, a Future that was given a continuation
+//! can no longer be waited on.
+//!
+//! \sa Promise, toStdFuture(), fromStdFuture()
+template<class T>
+class Future {
+public:
+    Future() = default;
+
+    Future(const Future& o) = delete;
+    Future& operator=(const Future& o) = delete;
+
+    Future(Future&& o) = default;
+    Future& operator=(Future&& o) = default;
+
+    //! \brief Waits for the value and retrieves it.
+    //!
+    //! \note Once the value is retrieved, the future no longer refers to a shared state.
+    T get()
+    {
+        detail::FutureAccess::state(*this)->wait();
+
+        auto state = std::move(state_);
+        return state->get();
+    }
+
+    //! \brief Checks whether the object refers to a shared state.
+    bool valid() const
+    {
+        return static_cast<bool>(state_);
+    }
+
+    //! \brief Checks, without blocking, whether the value is available.
+    bool isReady() const
+    {
+        return detail::FutureAccess::state(*this)->isReady();
+    }
+
+    //! \brief Waits for the value to become available.
+    void wait() const
+    {
+        detail::FutureAccess::state(*this)->wait();
+    }
+
+    //! \brief Waits, at most, the given amount of time for the value to become available.
+    template<class TRep, class TPeriod>
+    std::future_status wait_for(const std::chrono::duration<TRep, TPeriod>& timeout) const
+    {
+        return detail::FutureAccess::state(*this)->wait_for(timeout);
+    }
+
+private:
+    friend struct detail::FutureAccess;
+
+    explicit Future(std::shared_ptr<detail::SharedState<T>> state) :
+        state_(std::move(state))
+    {}
+
+    std::shared_ptr<detail::SharedState<T>> state_;
+};
+
+//! \brief The object used to make a #Future ready.
+//!
+//! \par Same as std::promise, a Promise that is destroyed without setting a value
+//! or an exception makes its #Future ready with an std::future_error.
+//!
+//! \sa Future
+template<class T>
+class Promise {
+public:
+    Promise() :
+        state_(std::make_shared<detail::SharedState<T>>())
+    {}
+
+    ~Promise()
+    {
+        abandon_();
+    }
+
+    Promise(const Promise& o) = delete;
+    Promise& operator=(const Promise& o) = delete;
+
+    Promise(Promise&& o) = default;
+
+    Promise& operator=(Promise&& o)
+    {
+        if (this != &o) {
+            abandon_();
+
+            state_ = std::move(o.state_);
+            isRetrieved_ = o.isRetrieved_;
+        }
+
+        return *this;
+    }
+
+    //! \brief Returns the #Future associated with the promise.
+    //!
+    //! \throw std::future_error if the future was already retrieved.
+    Future<T> get_future()
+    {
+        if (!state_) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+
+        if (isRetrieved_) {
+            throw std::future_error(std::future_errc::future_already_retrieved);
+        }
+
+        isRetrieved_ = true;
+
+        return detail::FutureAccess::make(state_);
+    }
+
+    //! \brief Stores the value, constructed from the given arguments, in the shared state.
+    //!
+    //! \note The continuation of the associated #Future, if any, is invoked by
+    //! the calling thread.
+    //!
+    //! \throw std::future_error if a value or an exception was already set.
+    template<class... Args>
+    void set_value(Args&&... args)
+    {
+        if (!state_) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+
+        state_->setValue(std::forward<Args>(args)...);
+    }
+
+    //! \brief Stores the exception in the shared state.
+    //!
+    //! \note The continuation of the associated #Future, if any, is invoked by
+    //! the calling thread.
+    //!
+    //! \throw std::future_error if a value or an exception was already set.
+    void set_exception(std::exception_ptr err)
+    {
+        if (!state_) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+
+        state_->setException(std::move(err));
+    }
+
+private:
+    void abandon_()
+    {
+        if (state_ && !state_->isSatisfied()) {
+            state_->setException(std::make_exception_ptr(
+                std::future_error(std::future_errc::broken_promise)));
+        }
+    }
+
+    std::shared_ptr<detail::SharedState<T>> state_;
+    bool isRetrieved_{ false };
+};
+
+namespace detail {
+
+template<class TOut, class TIn, class TFunc>
+void setResult(SharedState<TOut>& s, TFunc& cont, Future<TIn> f)
+{
+    s.setValue(cont(std::move(f)));
+}
+
+template<class TIn, class TFunc>
+void setResult(SharedState<void>& s, TFunc& cont, Future<TIn> f)
+{
+    cont(std::move(f));
+    s.setValue();
+}
+
+template<class T>
+void forwardValue(Future<T>& f, std::promise<T>& p)
+{
+    p.set_value(f.get());
+}
+
+inline void forwardValue(Future<void>& f, std::promise<void>& p)
+{
+    f.get();
+    p.set_value();
+}
+
+template<class T>
+void forwardValue(std::future<T>& f, Promise<T>& p)
+{
+    p.set_value(f.get());
+}
+
+inline void forwardValue(std::future<void>& f, Promise<void>& p)
+{
+    f.get();
+    p.set_value();
+}
+
+// The state of the future returned by then(), which is also the callback
+// attached to the input future, so that then() costs a single allocation
+template<class TIn, class TOut, class TFunc>
+class SharedStateWithContinuation : public SharedState<TOut>, public Callback {
+public:
+    SharedStateWithContinuation(Future<TIn> f, TFunc cont) :
+        f_(std::move(f)),
+        cont_(std::move(cont))
+    {}
+
+    static Future<TOut> start(Future<TIn> f, TFunc cont)
+    {
+        auto input = FutureAccess::state(f);
+
+        auto s = std::make_shared<SharedStateWithContinuation>(std::move(f), std::move(cont));
+
+        // Keeps the state alive until the continuation is invoked
+        s->self_ = s;
+
+        input->attach(s.get());
+
+        return FutureAccess::make<TOut>(std::move(s));
+    }
+
+    void invoke() override
+    {
+        auto self = std::move(self_);
+
+        try {
+            setResult(*this, cont_, std::move(f_));
+        }
+        catch (...) {
+            this->setException(std::current_exception());
+        }
+    }
+
+private:
+    std::shared_ptr<SharedStateWithContinuation> self_;
+    Future<TIn> f_;
+    TFunc cont_;
+};
+
+// The state of the future returned by all(), which counts down the input
+// futures as they become ready
+template<class T>
+class SharedStateWithAll : public SharedState<std::vector<Future<T>>> {
+public:
+    explicit SharedStateWithAll(std::vector<Future<T>> futures) :
+        futures_(std::move(futures)),
+        callbacks_(new Countdown[futures_.size()]),
+        remaining_(futures_.size() + 1)
+    {}
+
+    static Future<std::vector<Future<T>>> start(std::vector<Future<T>> futures)
+    {
+        for (const auto& f: futures) {
+            FutureAccess::state(f);
+        }
+
+        auto s = std::make_shared<SharedStateWithAll>(std::move(futures));
+
+        s->self_ = s;
+
+        for (std::size_t i = 0; i < s->futures_.size(); ++i) {
+            s->callbacks_[i].owner = s.get();
+            FutureAccess::state(s->futures_[i])->attach(&s->callbacks_[i]);
+        }
+
+        // Releases the extra count that guards against completing while attaching
+        s->countdown_();
+
+        return FutureAccess::make<std::vector<Future<T>>>(std::move(s));
+    }
+
+private:
+    struct Countdown : public Callback {
+        void invoke() override
+        {
+            owner->countdown_();
+        }
+
+        SharedStateWithAll* owner{ nullptr };
+    };
+
+    void countdown_()
+    {
+        if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            auto self = std::move(self_);
+            this->setValue(std::move(futures_));
+        }
+    }
+
+    std::shared_ptr<SharedStateWithAll> self_;
+    std::vector<Future<T>> futures_;
+    std::unique_ptr<Countdown[]> callbacks_;
+    std::atomic<std::size_t> remaining_;
+};
+
+template<class T>
+class FutureWithPromise final : public StaticTimedWaitable<FutureWithPromise<T>> {
+public:
+    FutureWithPromise(std::chrono::nanoseconds waitLimit,
+                      std::future<T> f,
+                      Promise<T> p) :
+        StaticTimedWaitable<FutureWithPromise>(std::move(waitLimit)),
+        f_(std::move(f)),
+        p_(std::move(p))
+    {}
+
+    FutureWithPromise(const FutureWithPromise& o) = delete;
+    FutureWithPromise& operator=(const FutureWithPromise& o) = delete;
+
+    FutureWithPromise(FutureWithPromise&& o) = default;
+    FutureWithPromise& operator=(FutureWithPromise&& o) = default;
+
+    bool timedWait(const std::chrono::microseconds& timeout)
+    {
+        return f_.wait_for(timeout) == std::future_status::ready;
+    }
+
+    void dispatch(std::exception_ptr err) override
+    {
+        if (err) {
+            p_.set_exception(err);
+            return;
+        }
+
+        try {
+            forwardValue(f_, p_);
+        }
+        catch (...) {
+            p_.set_exception(std::current_exception());
+        }
+    }
+
+private:
+    std::future<T> f_;
+    Promise<T> p_;
+};
+
+} // namespace detail
+
+//! \brief SFINAE meta-type that resolves to the type of the future returned by
+//! then() for the given native future.
+template<class TIn, class TFunc>
+using future_cont_result_t = Future<
+    typename std::result_of<typename std::decay<TFunc>::type(Future<TIn>)>::type
+>;
+
+//! \brief Creates a future that becomes ready when the input future becomes ready.
+//!
+//! \par The resulting future contains the value returned by invoking the given
+//! continuation function. The continuation is attached to the shared state of the
+//! input future and is invoked by the thread that makes the input future ready, or
+//! by the calling thread, if the input future is already ready. No #Executor polls
+//! the input future.
+//!
+//! \param f The input future to invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note The continuation should not block, since it runs in the thread that
+//! makes the input future ready.
+//!
+//! \sa Future, Promise
+//!
+//! \return A #Future that contains the value returned by the given continuation
+//! function.
+template<class TIn, class TFunc>
+future_cont_result_t<TIn, TFunc> then(Future<TIn> f, TFunc&& cont)
+{
+    using TOut = typename std::result_of<
+            typename std::decay<TFunc>::type(Future<TIn>)
+        >::type;
+
+    return detail::SharedStateWithContinuation<TIn, TOut, typename std::decay<TFunc>::type>::start(
+        std::move(f),
+        std::forward<TFunc>(cont)
+    );
+}
+
+//! \brief Creates a future that becomes ready when all the input futures become ready.
+//!
+//! \par The resulting future becomes ready, without any polling, in the thread that
+//! makes the last of the input futures ready.
+//!
+//! \param futures The vector that contains all the input futures.
+//!
+//! \sa Future, Promise
+//!
+//! \return A #Future that contains all the input futures, where all the contained
+//! futures are ready.
+template<class T>
+Future<std::vector<Future<T>>> all(std::vector<Future<T>> futures)
+{
+    return detail::SharedStateWithAll<T>::start(std::move(futures));
+}
+
+//! \brief Converts the given native future to an std::future.
+//!
+//! \param f The future to convert.
+//!
+//! \note The conversion attaches a continuation to f, so that it does not
+//! involve any polling.
+//!
+//! \return An std::future that becomes ready with the value or exception of f.
+template<class T>
+std::future<T> toStdFuture(Future<T> f)
+{
+    std::promise<T> p;
+
+    auto result = p.get_future();
+
+    then(std::move(f), [p = std::move(p)](Future<T> f) mutable {
+        try {
+            detail::forwardValue(f, p);
+        }
+        catch (...) {
+            p.set_exception(std::current_exception());
+        }
+    });
+
+    return result;
+}
+
+//! \brief Converts the given std::future to a native future.
+//!
+//! \par The shared state of an std::future cannot be observed, so the given
+//! executor polls it until it becomes ready, same as then().
+//!
+//! \param executor The object that waits for the given future to become ready.
+//! \param timeLimit The maximum time to wait for the given future to become ready.
+//! \param f The future to convert.
+//!
+//! \note If the total time for waiting the input future to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \return A #Future that becomes ready with the value or exception of f.
+template<class T>
+Future<T> fromStdFuture(std::shared_ptr<Executor> executor,
+                        std::chrono::nanoseconds timeLimit,
+                        std::future<T> f)
+{
+    Promise<T> p;
+
+    auto result = p.get_future();
+
+    executor->watch(std::make_unique<detail::FutureWithPromise<T>>(
+        std::move(timeLimit),
+        std::move(f),
+        std::move(p)
+    ));
+
+    return result;
+}
+
+//! \brief Converts the given std::future to a native future.
+//!
+//! \param executor The object that waits for the given future to become ready.
+//! \param f The future to convert.
+//!
+//! \note If the total time for waiting the input future to become ready exceeds
+//! a maximum threshold defined by the library (typically 1h), the resulting future
+//! becomes ready with an exception of type WaitableTimedOutException.
+//!
+//! \return A #Future that becomes ready with the value or exception of f.
+template<class T>
+Future<T> fromStdFuture(std::shared_ptr<Executor> executor, std::future<T> f)
+{
+    return fromStdFuture(std::move(executor), std::chrono::hours(1), std::move(f));
+}
+
+//! \brief Converts the given std::future to a native future.
+//!
+//! \par This function uses the default Executor object to wait for the given
+//! future to become ready.
+//!
+//! \param f The future to convert.
+//!
+//! \sa Default
+//!
+//! \return A #Future that becomes ready with the value or exception of f.
+template<class T>
+Future<T> fromStdFuture(std::future<T> f)
+{
+    return fromStdFuture(Default<Executor>(), std::chrono::hours(1), std::move(f));
+}
+
+} // namespace futures
+} // namespace thousandeyes
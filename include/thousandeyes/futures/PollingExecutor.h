@@ -10,12 +10,23 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <utility>
+#include <vector>
+
+#include <thousandeyes/futures/detail/InvokerWithThreadPool.h>
+#include <thousandeyes/futures/detail/WaitableQueue.h>
+#include <thousandeyes/futures/detail/typetraits.h>
 
 #include <thousandeyes/futures/Executor.h>
+#include <thousandeyes/futures/Tracer.h>
 #include <thousandeyes/futures/Waitable.h>
 
 namespace thousandeyes {
@@ -25,12 +36,38 @@ namespace futures {
 //! "watched" #Waitable instances become ready.
 //!
 //! \note The PollingExecutor dispatches the polling function via the TPollFunctor
-//! functor and, subsequently, dispatches a ready #Waitable via the TDispatchFunctor
-//! functor.
-template<class TPollFunctor, class TDispatchFunctor>
+//! functor and, subsequently, dispatches the ready #Waitable instances via the
+//! TDispatchFunctor functor. #Waitable instances that are found ready one after the
+//! other are dispatched together, as a single function. If the TDispatchFunctor
+//! functor can also be invoked as f(func, count), it is given the number of
+//! #Waitable instances that func dispatches.
+//!
+//! \note #Waitable instances of higher #Priority classes are polled and dispatched
+//! first. A lower priority class is polled at least once every few polls of the
+//! higher ones, so that it is not starved.
+//!
+//! \note #Waitable instances whose cancellation was requested are dispatched with a
+//! #WaitableCancelledException the next time they are polled, without waiting on them.
+//!
+//! \note At the start of each sweep, the deadlines of all the #Waitable instances are
+//! scanned in bulk (with SIMD instructions, where available) and the expired ones are
+//! polled first, so that the ones that time out are dispatched together. A deadline
+//! of 0, i.e., the default one of a #Waitable, is considered unset.
+//!
+//! \note #Waitable instances given to post() are not polled but dispatched via the
+//! TWorkFunctor functor, which, by default, runs them on a pool of threads that
+//! grows with the load up to the number of hardware threads.
+//!
+//! \note If the library is compiled with THOUSANDEYES_FUTURES_TRACING defined, the
+//! executor records the lifetime of each #Waitable to the #Tracer given to setTracer().
+template<class TPollFunctor,
+         class TDispatchFunctor,
+         class TWorkFunctor = detail::InvokerWithThreadPool>
 class PollingExecutor :
     public Executor,
-    public std::enable_shared_from_this<PollingExecutor<TPollFunctor, TDispatchFunctor>> {
+    public std::enable_shared_from_this<
+        PollingExecutor<TPollFunctor, TDispatchFunctor, TWorkFunctor>
+    > {
 public:
 
     //! \brief Constructs a #PollingExecutor with default-constructed functors
@@ -40,7 +77,25 @@ public:
     PollingExecutor(std::chrono::microseconds q) :
         q_(std::move(q)),
         pollFunc_(std::make_unique<TPollFunctor>()),
-        dispatchFunc_(std::make_unique<TDispatchFunctor>())
+        dispatchFunc_(std::make_unique<TDispatchFunctor>()),
+        workFunc_(std::make_unique<TWorkFunctor>())
+    {}
+
+    //! \brief Constructs a bounded #PollingExecutor with default-constructed
+    //! functors for polling and dispatching ready #Waitables
+    //!
+    //! \param q The polling timeout.
+    //! \param capacity The maximum number of pending #Waitables (0 for unbounded).
+    //! \param policy The behavior of watch() when the capacity is reached.
+    PollingExecutor(std::chrono::microseconds q,
+                    std::size_t capacity,
+                    OverflowPolicy policy) :
+        q_(std::move(q)),
+        capacity_(capacity),
+        policy_(policy),
+        pollFunc_(std::make_unique<TPollFunctor>()),
+        dispatchFunc_(std::make_unique<TDispatchFunctor>()),
+        workFunc_(std::make_unique<TWorkFunctor>())
     {}
 
     //! \brief Constructs a #PollingExecutor with the given functors
@@ -58,7 +113,33 @@ public:
         )),
         dispatchFunc_(std::make_unique<TDispatchFunctor>(
             std::forward<TDispatchFunctor>(dispatchFunc)
-        ))
+        )),
+        workFunc_(std::make_unique<TWorkFunctor>())
+    {}
+
+    //! \brief Constructs a bounded #PollingExecutor with the given functors
+    //! for polling and dispatching ready #Waitables
+    //!
+    //! \param q The polling timeout.
+    //! \param pollFunc The functor used to dispatch the polling function.
+    //! \param dispatchFunc The functor used to dispatch the ready #Waitables.
+    //! \param capacity The maximum number of pending #Waitables (0 for unbounded).
+    //! \param policy The behavior of watch() when the capacity is reached.
+    PollingExecutor(std::chrono::microseconds q,
+                    TPollFunctor&& pollFunc,
+                    TDispatchFunctor&& dispatchFunc,
+                    std::size_t capacity,
+                    OverflowPolicy policy) :
+        q_(std::move(q)),
+        capacity_(capacity),
+        policy_(policy),
+        pollFunc_(std::make_unique<TPollFunctor>(
+            std::forward<TPollFunctor>(pollFunc)
+        )),
+        dispatchFunc_(std::make_unique<TDispatchFunctor>(
+            std::forward<TDispatchFunctor>(dispatchFunc)
+        )),
+        workFunc_(std::make_unique<TWorkFunctor>())
     {}
 
     ~PollingExecutor()
@@ -67,27 +148,118 @@ public:
 
         pollFunc_.reset();
         dispatchFunc_.reset();
+        workFunc_.reset();
     }
 
     PollingExecutor(const PollingExecutor& o) = delete;
     PollingExecutor& operator=(const PollingExecutor& o) = delete;
 
+    //! \note When the executor is at its capacity, the given #Waitable is handled
+    //! according to the executor's #OverflowPolicy. The #OverflowPolicy::Block policy
+    //! never blocks the executor's own threads (e.g., a continuation that watches
+    //! another #Waitable); those watches are accepted over the capacity.
     void watch(std::unique_ptr<Waitable> w) override final
     {
+        std::unique_ptr<Waitable> shed;
         bool isActive;
+        bool isRejected = false;
+        bool startPoller = false;
         {
-            std::lock_guard<std::mutex> lock(mutex_);
+            std::unique_lock<std::mutex> lock(mutex_);
 
-            isActive = active_;
+            if (policy_ == OverflowPolicy::Block && !isWithinExecutor_()) {
+                while (isAccepting_() && isFull_()) {
+                    capacityCond_.wait(lock);
+                }
+            }
+
+            isActive = isAccepting_();
 
             if (isActive) {
-                waitables_.push(std::move(w));
+                if (isFull_() && policy_ == OverflowPolicy::Reject) {
+                    isRejected = true;
+                }
+                else {
+                    if (isFull_() && policy_ == OverflowPolicy::ShedOldest) {
+                        shed = shed_(w->priority());
+
+                        // Nothing of lower or equal priority to make room for w
+                        isRejected = !shed;
+                    }
+
+                    if (!isRejected) {
+                        trace_(TraceEvent::Watched, w.get());
+                        push_(std::move(w));
+                        ++size_;
+                        ++watched_;
 
-                if (isPollerRunning_) {
-                    return;
+                        startPoller = !isPollerRunning_;
+                        isPollerRunning_ = true;
+                    }
                 }
+            }
+        }
+
+        if (!isActive) {
+            cancel_(std::move(w), "Executor inactive");
+            return;
+        }
+
+        if (shed) {
+            overflow_(std::move(shed));
+        }
+
+        if (isRejected) {
+            overflow_(std::move(w));
+            return;
+        }
+
+        if (startPoller) {
+            poll_();
+        }
+    }
+
+    bool tryWatch(std::unique_ptr<Waitable>& w) override final
+    {
+        bool startPoller;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (!isAccepting_() || isFull_()) {
+                return false;
+            }
+
+            trace_(TraceEvent::Watched, w.get());
+            push_(std::move(w));
+            ++size_;
+            ++watched_;
+
+            startPoller = !isPollerRunning_;
+            isPollerRunning_ = true;
+        }
+
+        if (startPoller) {
+            poll_();
+        }
+
+        return true;
+    }
+
+    //! \note The given #Waitable is dispatched via the TWorkFunctor functor, unless
+    //! its cancellation was requested by then. Posted #Waitable instances are not
+    //! subject to the executor's capacity, but are waited for by drain().
+    void post(std::unique_ptr<Waitable> w) override final
+    {
+        bool isActive;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
 
-                isPollerRunning_ = true;
+            isActive = isAccepting_();
+            if (isActive) {
+                ++dispatching_;
+                ++watched_;
+                trace_(TraceEvent::Watched, w.get());
+                trace_(TraceEvent::Ready, w.get());
             }
         }
 
@@ -96,80 +268,580 @@ public:
             return;
         }
 
+        std::shared_ptr<Waitable> wShared = std::move(w);
+        std::weak_ptr<PollingExecutor> weak = this->shared_from_this();
+
+        (*workFunc_)([executor=owner_,
+                      weak=std::move(weak),
+                      trace=trace_,
+                      w=std::move(wShared)]() {
+            {
+                ExecutorScope scope(executor);
+
+                trace(TraceEvent::DispatchBegin, w.get());
+                w->dispatch(w->cancelled() ? cancelled_() : nullptr);
+                trace(TraceEvent::DispatchEnd, w.get());
+            }
+
+            if (auto self = weak.lock()) {
+                self->dispatched_(1);
+            }
+        });
+    }
+
+    //! \note All the pending #Waitable instances are cancelled in bulk, with a
+    //! single #WaitableWaitException, as one dispatched function.
+    void stop() override final
+    {
+        Queues pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            active_ = false;
+            pending.swap(waitables_);
+            for (const auto& queue: pending) {
+                size_ -= queue.size();
+            }
+        }
+
+        capacityCond_.notify_all();
+        drainCond_.notify_all();
+
+        std::size_t count = 0;
+        for (const auto& queue: pending) {
+            count += queue.size();
+        }
+
+        std::vector<std::unique_ptr<Waitable>> cancelled;
+        cancelled.reserve(count);
+
+        for (auto queue = pending.rbegin(); queue != pending.rend(); ++queue) {
+            while (!queue->empty()) {
+                cancelled.push_back(queue->pop().w);
+                trace_(TraceEvent::Ready, cancelled.back().get());
+            }
+        }
+
+        cancel_(cancelled, "Executor stoped");
+    }
+
+    //! \note While draining, watch() cancels the #Waitable objects given from
+    //! outside the executor, whereas the ones given by the continuations of the
+    //! pending #Waitable objects (e.g., chained futures) are accepted and drained too.
+    //!
+    //! \note drain() should not be called from within a continuation dispatched
+    //! by the same executor, since it would wait for its own completion.
+    bool drain(std::chrono::steady_clock::time_point deadline) override final
+    {
+        beginDrain();
+
+        bool drained = waitDrained(deadline);
+
+        stop();
+
+        return drained;
+    }
+
+    //! \brief Stops accepting new #Waitable objects from outside the executor,
+    //! without waiting for the pending ones, i.e., the first phase of drain().
+    void beginDrain()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        draining_ = true;
+        capacityCond_.notify_all();
+    }
+
+    //! \brief Waits, at most until the given deadline, for the pending #Waitable
+    //! objects to be dispatched, without stopping the executor.
+    //!
+    //! \param deadline The time after which to stop waiting.
+    //!
+    //! \return true if there are no pending #Waitable objects and false otherwise.
+    bool waitDrained(std::chrono::steady_clock::time_point deadline)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        return drainCond_.wait_until(lock, deadline, [this]() {
+            return !active_ || (size_ == 0 && dispatching_ == 0);
+        });
+    }
+
+    //! \brief Returns the number of #Waitable objects that the executor has
+    //! accepted so far, via watch(), tryWatch() or post().
+    std::uint64_t watchCount() const
+    {
+        return watched_.load(std::memory_order_acquire);
+    }
+
+    //! \brief Sets the identity of the executor that the threads of the current
+    //! one act on behalf of, e.g., the #ShardedExecutor that the current one is a
+    //! shard of.
+    //!
+    //! \param owner The identity shared by all the executors of the same owner.
+    //!
+    //! \note Executors of the same owner treat the #Waitable objects watched by
+    //! each other's continuations as their own, e.g., while draining.
+    //!
+    //! \note The owner should be set before the executor is given any #Waitable.
+    void setOwner(const void* owner)
+    {
+        owner_ = owner;
+    }
+
+    //! \brief Sets the #Tracer that records the lifetime of the #Waitable objects
+    //! given to the executor.
+    //!
+    //! \param tracer The tracer to record to, or nullptr to stop recording.
+    //!
+    //! \note The tracer should be set before the executor is given any #Waitable.
+    //! Without THOUSANDEYES_FUTURES_TRACING defined, nothing is recorded.
+    void setTracer(std::shared_ptr<Tracer> tracer)
+    {
+        trace_ = detail::TraceHandle(std::move(tracer));
+    }
+
+private:
+    using Dispatched = std::pair<std::unique_ptr<Waitable>, std::exception_ptr>;
+    using Entry = detail::WaitableQueue::Entry;
+    using Queues = std::array<detail::WaitableQueue, 3>;
+
+    //! \brief The number of consecutive times that a priority class with pending
+    //! #Waitables can be passed over in favor of higher ones.
+    static constexpr std::size_t starvationLimit_ = 16;
+
+    //! \brief Marks the current thread as running on behalf of the executor.
+    class ExecutorScope {
+    public:
+        explicit ExecutorScope(const void* executor) :
+            prev_(current_())
+        {
+            current_() = executor;
+        }
+
+        ~ExecutorScope()
+        {
+            current_() = prev_;
+        }
+
+        static const void*& current_()
+        {
+            static thread_local const void* executor = nullptr;
+            return executor;
+        }
+
+    private:
+        const void* prev_;
+    };
+
+    inline bool isWithinExecutor_() const
+    {
+        return ExecutorScope::current_() == owner_;
+    }
+
+    inline bool isAccepting_() const
+    {
+        return active_ && (!draining_ || isWithinExecutor_());
+    }
+
+    inline bool isFull_() const
+    {
+        return capacity_ != 0 && size_ >= capacity_;
+    }
+
+    static inline std::size_t index_(Priority priority)
+    {
+        return static_cast<std::size_t>(priority);
+    }
+
+    inline bool empty_() const
+    {
+        return std::all_of(waitables_.begin(), waitables_.end(), [](const auto& queue) {
+            return queue.empty();
+        });
+    }
+
+    inline std::size_t count_() const
+    {
+        std::size_t count = 0;
+        for (const auto& queue: waitables_) {
+            count += queue.size();
+        }
+
+        return count;
+    }
+
+    inline void push_(std::unique_ptr<Waitable> w)
+    {
+        waitables_[index_(w->priority())].push(std::move(w));
+    }
+
+    inline void push_(Entry e)
+    {
+        waitables_[index_(e.w->priority())].push(std::move(e));
+    }
+
+    //! \brief Removes the next #Waitable to poll: the oldest one of the highest
+    //! priority class, unless a lower class has been passed over too many times.
+    inline Entry pop_()
+    {
+        std::size_t pick = waitables_.size();
+        for (std::size_t i = waitables_.size(); i-- > 0;) {
+            if (waitables_[i].empty()) {
+                continue;
+            }
+
+            if (pick == waitables_.size()) {
+                pick = i;
+            }
+            else if (skipped_[i] >= starvationLimit_) {
+                pick = i;
+                break;
+            }
+        }
+
+        for (std::size_t i = 0; i < pick; ++i) {
+            if (!waitables_[i].empty()) {
+                ++skipped_[i];
+            }
+        }
+        skipped_[pick] = 0;
+
+        return waitables_[pick].pop();
+    }
+
+    //! \brief Removes the #Waitables whose deadlines are set and have been exceeded,
+    //! of the higher priority classes first, scanning the deadlines in bulk.
+    inline void takeExpired_(std::chrono::nanoseconds now, std::vector<Entry>& expired)
+    {
+        for (std::size_t i = waitables_.size(); i-- > 0;) {
+            waitables_[i].takeExpired(now, expired);
+        }
+    }
+
+    //! \brief Removes the oldest #Waitable of the lowest priority class that is not
+    //! higher than the given one, if any.
+    inline std::unique_ptr<Waitable> shed_(Priority priority)
+    {
+        for (std::size_t i = 0; i <= index_(priority); ++i) {
+            if (!waitables_[i].empty()) {
+                --size_;
+                return waitables_[i].pop().w;
+            }
+        }
+
+        return nullptr;
+    }
+
+    inline void poll_()
+    {
         (*pollFunc_)([this, keep=this->shared_from_this()]() {
+            ExecutorScope scope(owner_);
+
+            std::vector<Dispatched> ready;
+            std::size_t released = 0;
+
+            // The clock is read once per sweep over the pending waitables, and
+            // after waits that may have blocked
+            std::chrono::nanoseconds now{ 0 };
+            std::size_t sweep = 0;
+            bool isStale = true;
+
+            // The waitables found expired at the start of the current sweep, which
+            // are polled first, so that the ones that time out are dispatched together
+            std::vector<Entry> expired;
+            std::size_t nextExpired = 0;
+
             while (true) {
 
-                std::unique_ptr<Waitable> w;
+                Entry e;
                 {
                     std::lock_guard<std::mutex> lock(mutex_);
 
-                    if (waitables_.empty() || !active_) {
+                    size_ -= released;
+                    dispatching_ += released;
+
+                    if ((empty_() && nextExpired == expired.size()) || !active_) {
                         isPollerRunning_ = false;
+
+                        // The expired waitables not polled yet are out of the reach of stop()
+                        std::size_t count = expired.size() - nextExpired;
+                        if (count != 0) {
+                            size_ -= count;
+                            dispatching_ += count;
+                            released += count;
+
+                            auto error = WaitableWaitException("Executor stoped");
+                            for (; nextExpired < expired.size(); ++nextExpired) {
+                                trace_(TraceEvent::Ready, expired[nextExpired].w.get());
+                                ready.emplace_back(std::move(expired[nextExpired].w),
+                                                   std::make_exception_ptr(error));
+                            }
+                        }
+
                         break;
                     }
 
-                    w = std::move(waitables_.front());
-                    waitables_.pop();
+                    if (sweep == 0) {
+                        sweep = count_();
+                        now = toTimestamp(std::chrono::steady_clock::now());
+                        isStale = false;
+
+                        expired.clear();
+                        nextExpired = 0;
+                        takeExpired_(now, expired);
+                    }
+
+                    if (nextExpired < expired.size()) {
+                        e = std::move(expired[nextExpired++]);
+                    }
+                    else {
+                        e = pop_();
+                    }
+
+                    --sweep;
+                }
+
+                if (isStale) {
+                    now = toTimestamp(std::chrono::steady_clock::now());
+                    isStale = false;
+                }
+
+                if (released != 0) {
+                    release_(released);
+                    released = 0;
+                }
+
+                // While there are ready waitables pending dispatch, the rest are
+                // only checked without blocking, so that the batch is not delayed
+                auto q = ready.empty() ? q_ : std::chrono::microseconds(0);
+
+                if (e.w->cancelled()) {
+                    trace_(TraceEvent::Ready, e.w.get());
+                    ready.emplace_back(std::move(e.w), cancelled_());
+                    ++released;
+                    continue;
                 }
 
                 try {
-                    if (!w->wait(q_)) {
-                        std::lock_guard<std::mutex> lock(mutex_);
-                        waitables_.push(std::move(w));
+                    if (poll_(*e.w, q, now)) {
+                        trace_(TraceEvent::Ready, e.w.get());
+                        ready.emplace_back(std::move(e.w), nullptr);
+                        ++released;
                         continue;
                     }
 
-                    dispatch_(std::move(w), nullptr);
+                    isStale = q.count() != 0;
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        if (active_) {
+                            push_(std::move(e));
+                        }
+                    }
+
+                    if (e.w) {
+                        // The executor was stopped while w was being polled
+                        trace_(TraceEvent::Ready, e.w.get());
+                        auto error = WaitableWaitException("Executor stoped");
+                        ready.emplace_back(std::move(e.w), std::make_exception_ptr(error));
+                        ++released;
+                        continue;
+                    }
                 }
                 catch (...) {
-                    dispatch_(std::move(w), std::current_exception());
+                    trace_(TraceEvent::Ready, e.w.get());
+                    ready.emplace_back(std::move(e.w), std::current_exception());
+                    ++released;
+                    continue;
                 }
+
+                dispatch_(ready);
             }
+
+            release_(released);
+            dispatch_(ready);
         });
     }
 
-    void stop() override final
+    //! \brief Waits on the given #Waitable, tracing the wait.
+    inline bool poll_(Waitable& w,
+                      const std::chrono::microseconds& q,
+                      const std::chrono::nanoseconds& now)
     {
-        std::queue<std::unique_ptr<Waitable>> pending;
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
+        trace_(TraceEvent::PollBegin, &w);
 
-            active_ = false;
-            pending.swap(waitables_);
+        try {
+            bool isReady = w.wait(q, now);
+            trace_(TraceEvent::PollEnd, &w);
+            return isReady;
+        }
+        catch (...) {
+            trace_(TraceEvent::PollEnd, &w);
+            throw;
+        }
+    }
+
+    inline void release_(std::size_t count)
+    {
+        if (policy_ != OverflowPolicy::Block || capacity_ == 0 || count == 0) {
+            return;
         }
 
-        while (!pending.empty()) {
-            cancel_(std::move(pending.front()), "Executor stoped");
-            pending.pop();
+        if (count == 1) {
+            capacityCond_.notify_one();
+        }
+        else {
+            capacityCond_.notify_all();
+        }
+    }
+
+    inline void dispatch_(std::vector<Dispatched>& ready)
+    {
+        if (ready.empty()) {
+            return;
+        }
+
+        std::stable_sort(ready.begin(), ready.end(), [](const Dispatched& l, const Dispatched& r) {
+            return l.first->priority() > r.first->priority();
+        });
+
+        // All the ready waitables are handed to the dispatchFunc_ at once
+        auto batch = std::make_shared<std::vector<Dispatched>>();
+        batch->swap(ready);
+
+        std::weak_ptr<PollingExecutor> weak = this->shared_from_this();
+        std::size_t count = batch->size();
+
+        invoke_([executor=owner_,
+                 weak=std::move(weak),
+                 trace=trace_,
+                 batch=std::move(batch)]() {
+            {
+                ExecutorScope scope(executor);
+
+                for (Dispatched& d: *batch) {
+                    trace(TraceEvent::DispatchBegin, d.first.get());
+                    d.first->dispatch(std::move(d.second));
+                    trace(TraceEvent::DispatchEnd, d.first.get());
+                    d.first.reset();
+                }
+            }
+
+            if (auto self = weak.lock()) {
+                self->dispatched_(batch->size());
+            }
+        }, count);
+    }
+
+    inline void invoke_(std::function<void()> f, std::size_t count)
+    {
+        invoke_(std::move(f), count, detail::has_counted_call<TDispatchFunctor>());
+    }
+
+    inline void invoke_(std::function<void()> f, std::size_t count, std::true_type)
+    {
+        (*dispatchFunc_)(std::move(f), count);
+    }
+
+    inline void invoke_(std::function<void()> f, std::size_t /* count */, std::false_type)
+    {
+        (*dispatchFunc_)(std::move(f));
+    }
+
+    inline void dispatched_(std::size_t count)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        dispatching_ -= count;
+        if (draining_) {
+            drainCond_.notify_all();
         }
     }
 
-private:
     inline void dispatch_(std::unique_ptr<Waitable> w, std::exception_ptr error)
     {
         // Using shared_ptr to enable copy-ability of the lambda, otherwise the
         // dispatchFunc_ would not be able to accept it as function<void()>
         std::shared_ptr<Waitable> wShared = std::move(w);
-        (*dispatchFunc_)([w=std::move(wShared), error=std::move(error)]() {
+        (*dispatchFunc_)([executor=owner_,
+                          trace=trace_,
+                          w=std::move(wShared),
+                          error=std::move(error)]() {
+            ExecutorScope scope(executor);
+
+            trace(TraceEvent::DispatchBegin, w.get());
             w->dispatch(error);
+            trace(TraceEvent::DispatchEnd, w.get());
         });
     }
 
+    inline void cancel_(std::vector<std::unique_ptr<Waitable>>& pending, const std::string& message)
+    {
+        if (pending.empty()) {
+            return;
+        }
+
+        // All the waitables share the same error and are dispatched as one function
+        auto error = std::make_exception_ptr(WaitableWaitException(message));
+        auto batch = std::make_shared<std::vector<std::unique_ptr<Waitable>>>(std::move(pending));
+        pending.clear();
+
+        std::size_t count = batch->size();
+
+        invoke_([executor=owner_,
+                 trace=trace_,
+                 batch=std::move(batch),
+                 error=std::move(error)]() {
+            ExecutorScope scope(executor);
+
+            for (std::unique_ptr<Waitable>& w: *batch) {
+                trace(TraceEvent::DispatchBegin, w.get());
+                w->dispatch(error);
+                trace(TraceEvent::DispatchEnd, w.get());
+                w.reset();
+            }
+        }, count);
+    }
+
     inline void cancel_(std::unique_ptr<Waitable> w, const std::string& message)
     {
         auto error = std::make_exception_ptr(WaitableWaitException(message));
         dispatch_(std::move(w), std::move(error));
     }
 
+    static inline std::exception_ptr cancelled_()
+    {
+        return std::make_exception_ptr(WaitableCancelledException("Waitable cancelled"));
+    }
+
+    inline void overflow_(std::unique_ptr<Waitable> w)
+    {
+        auto error = std::make_exception_ptr(ExecutorOverflowException("Executor overflow"));
+        dispatch_(std::move(w), std::move(error));
+    }
+
     const std::chrono::microseconds q_;
+    const std::size_t capacity_{ 0 };
+    const OverflowPolicy policy_{ OverflowPolicy::Reject };
 
     std::mutex mutex_;
-    std::queue<std::unique_ptr<Waitable>> waitables_;
+    std::condition_variable capacityCond_;
+    std::condition_variable drainCond_;
+    Queues waitables_;
+    std::array<std::size_t, 3> skipped_{};
+    std::size_t size_{ 0 };
+    std::size_t dispatching_{ 0 };
+    std::atomic<std::uint64_t> watched_{ 0 };
     bool active_{ true };
+    bool draining_{ false };
     bool isPollerRunning_{ false };
+    const void* owner_{ this };
+    detail::TraceHandle trace_;
 
     std::unique_ptr<TPollFunctor> pollFunc_;
     std::unique_ptr<TDispatchFunctor> dispatchFunc_;
+    std::unique_ptr<TWorkFunctor> workFunc_;
 };
 
 } // namespace futures
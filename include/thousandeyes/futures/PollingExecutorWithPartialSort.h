@@ -11,11 +11,13 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <iterator>
 #include <memory>
 #include <mutex>
+#include <utility>
 #include <vector>
 
 #include <thousandeyes/futures/Executor.h>
@@ -29,8 +31,9 @@ namespace futures {
 //! also partially sorts the waitables left and right of their deadline median value.
 //!
 //! \note The PollingExecutorWithPartialSort dispatches the polling function via the TPollFunctor
-//! functor and, subsequently, dispatches a ready #Waitable via the TDispatchFunctor
-//! functor.
+//! functor and, subsequently, dispatches the ready #Waitable instances via the
+//! TDispatchFunctor functor. #Waitable instances that are found ready one after the
+//! other are dispatched together, as a single function.
 template<class TPollFunctor, class TDispatchFunctor>
 class PollingExecutorWithPartialSort :
     public Executor,
@@ -105,6 +108,8 @@ public:
         });
     }
 
+    //! \note All the pending #Waitable instances are cancelled in bulk, with a
+    //! single #WaitableWaitException, as one dispatched function.
     void stop() override final
     {
         std::vector<std::unique_ptr<Waitable>> pending;
@@ -115,12 +120,32 @@ public:
             pending.swap(waitables_);
         }
 
-        for (std::unique_ptr<Waitable>& w: pending) {
-            cancel_(std::move(w), "Executor stoped");
-        }
+        stopped_.store(true, std::memory_order_relaxed);
+
+        cancel_(pending, "Executor stoped");
     }
 
 private:
+    using Dispatched = std::pair<std::unique_ptr<Waitable>, std::exception_ptr>;
+
+    inline void dispatch_(std::vector<Dispatched>& ready)
+    {
+        if (ready.empty()) {
+            return;
+        }
+
+        // All the ready waitables are handed to the dispatchFunc_ at once
+        auto batch = std::make_shared<std::vector<Dispatched>>();
+        batch->swap(ready);
+
+        (*dispatchFunc_)([batch=std::move(batch)]() {
+            for (Dispatched& d: *batch) {
+                d.first->dispatch(std::move(d.second));
+                d.first.reset();
+            }
+        });
+    }
+
     inline void dispatch_(std::unique_ptr<Waitable> w, std::exception_ptr error)
     {
         // Using shared_ptr to enable copy-ability of the lambda, otherwise the
@@ -131,17 +156,77 @@ private:
         });
     }
 
+    inline void cancel_(std::vector<std::unique_ptr<Waitable>>& pending, const std::string& message)
+    {
+        if (pending.empty()) {
+            return;
+        }
+
+        // All the waitables share the same error and are dispatched as one function
+        auto error = std::make_exception_ptr(WaitableWaitException(message));
+        auto batch = std::make_shared<std::vector<std::unique_ptr<Waitable>>>(std::move(pending));
+        pending.clear();
+
+        (*dispatchFunc_)([batch=std::move(batch), error=std::move(error)]() {
+            for (std::unique_ptr<Waitable>& w: *batch) {
+                w->dispatch(error);
+                w.reset();
+            }
+        });
+    }
+
     inline void cancel_(std::unique_ptr<Waitable> w, const std::string& message)
     {
         auto error = std::make_exception_ptr(WaitableWaitException(message));
         dispatch_(std::move(w), std::move(error));
     }
 
+    inline void poll_(std::unique_ptr<Waitable>& w,
+                      std::vector<Dispatched>& ready,
+                      std::chrono::nanoseconds& now)
+    {
+        // Once stopped, the rest of the sweep is skipped, so that the remaining
+        // waitables are cancelled right away
+        if (!w || stopped_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        // While there are ready waitables pending dispatch, the rest are
+        // only checked without blocking, so that the batch is not delayed
+        auto q = ready.empty() ? q_ : std::chrono::microseconds(0);
+
+        if (w->cancelled()) {
+            auto error = std::make_exception_ptr(WaitableCancelledException("Waitable cancelled"));
+            ready.emplace_back(std::move(w), std::move(error));
+            return;
+        }
+
+        try {
+            if (w->wait(q, now)) {
+                ready.emplace_back(std::move(w), nullptr);
+                return;
+            }
+        }
+        catch (...) {
+            ready.emplace_back(std::move(w), std::current_exception());
+            return;
+        }
+
+        // The wait may have blocked for up to q
+        if (q.count() != 0) {
+            now = toTimestamp(std::chrono::steady_clock::now());
+        }
+
+        dispatch_(ready);
+    }
+
     inline void poll_()
     {
         std::vector<std::unique_ptr<Waitable>> polling;
         polling.reserve(1000);
 
+        std::vector<Dispatched> ready;
+
         while (true) {
             bool isPollerRunning;
             {
@@ -160,9 +245,7 @@ private:
             }
 
             if (!isPollerRunning) {
-                for (std::unique_ptr<Waitable>& w: polling) {
-                    cancel_(std::move(w), "Executor stoped");
-                }
+                cancel_(polling, "Executor stoped");
                 return;
             }
 
@@ -172,31 +255,22 @@ private:
                              middleIter,
                              polling.end(),
                              [](const auto& a, const auto& b) {
-                return a->compare(*b) < std::chrono::milliseconds(0);
+                return a->compare(*b) < std::chrono::nanoseconds(0);
             });
 
-            std::for_each(polling.begin(), middleIter, [this](std::unique_ptr<Waitable>& w) {
-                try {
-                    if (w->wait(q_)) {
-                        dispatch_(std::move(w), nullptr);
-                    }
-                }
-                catch (...) {
-                    dispatch_(std::move(w), std::current_exception());
-                }
+            // The clock is read once per sweep, and after waits that may have blocked
+            auto now = toTimestamp(std::chrono::steady_clock::now());
+
+            std::for_each(polling.begin(), middleIter, [this, &ready, &now](std::unique_ptr<Waitable>& w) {
+                poll_(w, ready, now);
             });
 
-            std::for_each(polling.begin(), polling.end(), [this](std::unique_ptr<Waitable>& w) {
-                try {
-                    if (w && w->wait(q_)) {
-                        dispatch_(std::move(w), nullptr);
-                    }
-                }
-                catch (...) {
-                    dispatch_(std::move(w), std::current_exception());
-                }
+            std::for_each(polling.begin(), polling.end(), [this, &ready, &now](std::unique_ptr<Waitable>& w) {
+                poll_(w, ready, now);
             });
 
+            dispatch_(ready);
+
             // Remove dispatched waitables
             polling.erase(std::remove_if(polling.begin(),
                                          polling.end(),
@@ -211,6 +285,7 @@ private:
     std::vector<std::unique_ptr<Waitable>> waitables_;
     bool active_{ true };
     bool isPollerRunning_{ false };
+    std::atomic<bool> stopped_{ false };
 
     std::unique_ptr<TPollFunctor> pollFunc_;
     std::unique_ptr<TDispatchFunctor> dispatchFunc_;
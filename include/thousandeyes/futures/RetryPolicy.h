@@ -0,0 +1,74 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <random>
+
+namespace thousandeyes {
+namespace futures {
+
+//! \brief Describes how retry() repeats failed attempts.
+//!
+//! \par The delay before the n-th retry grows exponentially, starting from
+//! initialDelay and multiplied by multiplier after each attempt, up to maxDelay.
+//! A jitter of j removes a random fraction of up to j from each delay, so that
+//! clients that failed together do not retry together.
+//!
+//! \sa retry()
+struct RetryPolicy {
+    //! \brief The maximum number of attempts, including the first one.
+    std::size_t maxAttempts{ 3 };
+
+    //! \brief The delay before the first retry.
+    std::chrono::nanoseconds initialDelay{ std::chrono::milliseconds(100) };
+
+    //! \brief The factor by which the delay grows after each retry.
+    double multiplier{ 2.0 };
+
+    //! \brief The upper bound of the delay between two attempts.
+    std::chrono::nanoseconds maxDelay{ std::chrono::seconds(30) };
+
+    //! \brief The fraction, in [0, 1], of each delay that is randomized.
+    //!
+    //! \note Values outside of [0, 1] are clamped to it.
+    double jitter{ 0.0 };
+
+    //! \brief The maximum time for all the attempts, including the delays
+    //! between them.
+    std::chrono::nanoseconds timeLimit{ std::chrono::hours(1) };
+
+    //! \brief Returns the delay after the given number of failed attempts.
+    //!
+    //! \param attempts The number of failed attempts so far (>= 1).
+    inline std::chrono::nanoseconds delay(std::size_t attempts) const
+    {
+        double d = static_cast<double>(initialDelay.count());
+        for (std::size_t i = 1; i < attempts && d < maxDelay.count(); ++i) {
+            d *= multiplier;
+        }
+
+        d = std::min(d, static_cast<double>(maxDelay.count()));
+
+        if (jitter > 0.0) {
+            thread_local std::mt19937_64 engine{ std::random_device{}() };
+            std::uniform_real_distribution<double> dist(0.0, std::min(jitter, 1.0));
+            d -= d * dist(engine);
+        }
+
+        return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(d));
+    }
+};
+
+} // namespace futures
+} // namespace thousandeyes
@@ -0,0 +1,278 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <thousandeyes/futures/Executor.h>
+#include <thousandeyes/futures/Waitable.h>
+#include <thousandeyes/futures/detail/typetraits.h>
+
+namespace thousandeyes {
+namespace futures {
+
+//! \brief The strategy used by the #ShardedExecutor to select the shard
+//! that watches a given #Waitable.
+enum class ShardRouting {
+    //! Consecutive #Waitable objects are assigned to consecutive shards.
+    RoundRobin,
+    //! All the #Waitable objects watched from the same thread are assigned
+    //! to the same shard.
+    ThreadId
+};
+
+//! \brief An implementation of the #Executor that distributes the "watched"
+//! #Waitable instances over many independent executor instances (shards).
+//!
+//! \note Each shard polls and dispatches its #Waitable objects independently of
+//! the other shards, so the time-to-detect-ready lag of each #Waitable depends
+//! only on the number of active #Waitable objects in its own shard.
+template<class TExecutor>
+class ShardedExecutor : public Executor {
+public:
+    //! \brief Constructs a #ShardedExecutor with the given number of
+    //! shards, each one constructed with the given polling timeout.
+    //!
+    //! \param shardCount The number of shards to distribute the #Waitables over.
+    //! \param q The polling timeout of each shard.
+    //! \param routing The strategy used to assign #Waitables to shards.
+    ShardedExecutor(std::size_t shardCount,
+                    std::chrono::microseconds q,
+                    ShardRouting routing = ShardRouting::RoundRobin) :
+        routing_(routing),
+        watchCounts_(shardCount)
+    {
+        if (shardCount == 0) {
+            throw std::invalid_argument("ShardedExecutor requires at least one shard");
+        }
+
+        shards_.reserve(shardCount);
+        for (std::size_t i = 0; i < shardCount; ++i) {
+            shards_.push_back(std::make_shared<TExecutor>(q));
+        }
+
+        own_(detail::has_phased_drain<TExecutor>());
+    }
+
+    //! \brief Constructs a #ShardedExecutor from the given, already
+    //! constructed, shards.
+    //!
+    //! \param shards The executors to distribute the #Waitables over.
+    //! \param routing The strategy used to assign #Waitables to shards.
+    //!
+    //! \note If the shards support it (e.g., #PollingExecutor shards), the
+    //! #ShardedExecutor becomes their owner (see PollingExecutor::setOwner()),
+    //! so that continuations can be chained across shards while draining. The
+    //! given shards should then be used only through the #ShardedExecutor, i.e.,
+    //! via watch() or shard(), and not be shared with other executors.
+    explicit ShardedExecutor(std::vector<std::shared_ptr<TExecutor>> shards,
+                             ShardRouting routing = ShardRouting::RoundRobin) :
+        routing_(routing),
+        shards_(std::move(shards)),
+        watchCounts_(shards_.size())
+    {
+        if (shards_.empty()) {
+            throw std::invalid_argument("ShardedExecutor requires at least one shard");
+        }
+
+        own_(detail::has_phased_drain<TExecutor>());
+    }
+
+    ~ShardedExecutor()
+    {
+        stop();
+    }
+
+    ShardedExecutor(const ShardedExecutor& o) = delete;
+    ShardedExecutor& operator=(const ShardedExecutor& o) = delete;
+
+    void watch(std::unique_ptr<Waitable> w) override final
+    {
+        std::size_t index = route_();
+
+        watchCounts_[index].fetch_add(1, std::memory_order_relaxed);
+        shards_[index]->watch(std::move(w));
+    }
+
+    bool tryWatch(std::unique_ptr<Waitable>& w) override final
+    {
+        std::size_t index = route_();
+
+        if (!shards_[index]->tryWatch(w)) {
+            return false;
+        }
+
+        watchCounts_[index].fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void post(std::unique_ptr<Waitable> w) override final
+    {
+        std::size_t index = route_();
+
+        watchCounts_[index].fetch_add(1, std::memory_order_relaxed);
+        shards_[index]->post(std::move(w));
+    }
+
+    void stop() override final
+    {
+        for (auto& shard: shards_) {
+            shard->stop();
+        }
+    }
+
+    //! \note If the shards support it (e.g., #PollingExecutor shards), all of them
+    //! stop accepting #Waitable objects from outside at once and are stopped only
+    //! when none of them has pending #Waitable objects, so that continuations can
+    //! be chained across shards while draining, including the ones watched via the
+    //! shards obtained from shard(). Otherwise, the shards are drained
+    //! one after the other, with the same deadline.
+    bool drain(std::chrono::steady_clock::time_point deadline) override final
+    {
+        return drain_(deadline, detail::has_phased_drain<TExecutor>());
+    }
+
+    //! \brief Obtains the shard that is associated with the given key.
+    //!
+    //! \param key The caller-supplied key (e.g., a session or connection id).
+    //!
+    //! \return The shard that should watch all the #Waitables related to the key.
+    //!
+    //! \note The returned executor can be passed directly to then() and all()
+    //! to keep the continuations of the same key on the same shard.
+    std::shared_ptr<TExecutor> shard(std::size_t key) const
+    {
+        return shards_[key % shards_.size()];
+    }
+
+    //! \brief Returns the number of shards.
+    std::size_t shardCount() const
+    {
+        return shards_.size();
+    }
+
+    //! \brief Returns, per shard, the number of #Waitables that were routed to it
+    //! via the watch() method of the #ShardedExecutor.
+    std::vector<std::uint64_t> watchCounts() const
+    {
+        std::vector<std::uint64_t> result;
+        result.reserve(watchCounts_.size());
+        for (const auto& count: watchCounts_) {
+            result.push_back(count.load(std::memory_order_relaxed));
+        }
+        return result;
+    }
+
+private:
+    inline void own_(std::true_type)
+    {
+        for (auto& shard: shards_) {
+            shard->setOwner(this);
+        }
+    }
+
+    inline void own_(std::false_type)
+    {}
+
+    // Counted by the shards themselves, so that the #Waitables watched directly
+    // via the shards obtained from shard() are counted too
+    inline std::uint64_t watchCount_() const
+    {
+        std::uint64_t result = 0;
+        for (const auto& shard: shards_) {
+            result += shard->watchCount();
+        }
+        return result;
+    }
+
+    bool drain_(std::chrono::steady_clock::time_point deadline, std::true_type)
+    {
+        for (auto& shard: shards_) {
+            shard->beginDrain();
+        }
+
+        // A shard can be given new waitables by the continuations of another shard
+        // after it was found drained. Continuations still running are noticed by
+        // the pass after the one in which they were watched, so the shards are
+        // drained once two consecutive passes find them all empty, without any
+        // waitables routed in the meantime
+        bool drained = false;
+        std::size_t cleanPasses = 0;
+        std::uint64_t count = watchCount_();
+
+        while (true) {
+            bool isClean = true;
+            for (auto& shard: shards_) {
+                if (!shard->waitDrained(deadline)) {
+                    isClean = false;
+                    break;
+                }
+            }
+
+            if (!isClean) {
+                break;
+            }
+
+            std::uint64_t newCount = watchCount_();
+            cleanPasses = newCount == count ? cleanPasses + 1 : 0;
+            count = newCount;
+
+            if (cleanPasses == 2) {
+                drained = true;
+                break;
+            }
+
+            if (std::chrono::steady_clock::now() >= deadline) {
+                break;
+            }
+        }
+
+        stop();
+
+        return drained;
+    }
+
+    bool drain_(std::chrono::steady_clock::time_point deadline, std::false_type)
+    {
+        bool drained = true;
+        for (auto& shard: shards_) {
+            drained = shard->drain(deadline) && drained;
+        }
+
+        return drained;
+    }
+
+    inline std::size_t route_()
+    {
+        if (routing_ == ShardRouting::ThreadId) {
+            return std::hash<std::thread::id>()(std::this_thread::get_id()) % shards_.size();
+        }
+
+        return nextShard_.fetch_add(1, std::memory_order_relaxed) % shards_.size();
+    }
+
+    const ShardRouting routing_;
+
+    std::vector<std::shared_ptr<TExecutor>> shards_;
+
+    std::atomic<std::size_t> nextShard_{ 0 };
+    std::vector<std::atomic<std::uint64_t>> watchCounts_;
+};
+
+} // namespace futures
+} // namespace thousandeyes
@@ -10,8 +10,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <string>
+#include <utility>
 
 #include <thousandeyes/futures/Waitable.h>
 
@@ -28,22 +30,19 @@ public:
     {}
 };
 
-//! \brief A Waitable Interface to represent objects whose wait() method
+//! \brief A Waitable base class to represent objects whose wait() method
 //! can throw a #WaitableTimedOutException if the object is not ready
 //! and the #Waitable object's deadline has been exceeded.
-class TimedWaitable : public Waitable {
+//!
+//! \par The TDerived class provides the specific waiting logic with a (non-virtual)
+//! timedWait() method, which wait() invokes statically. When TDerived is final,
+//! polling the object costs a single virtual call to wait(), in which the
+//! readiness check of TDerived can be inlined.
+//!
+//! \sa TimedWaitable
+template<class TDerived>
+class StaticTimedWaitable : public Waitable {
 public:
-    //! \brief Creates a Waitable object whose wait() method can throw a
-    //! #WaitableTimedOutException if the object is not ready and the
-    //! given timeout has passed. In those cases the object's expired
-    //! method should return true.
-    //!
-    //! \param timeout The timeout after which the object is considered
-    //! expired.
-    explicit TimedWaitable(std::chrono::microseconds timeout) :
-        Waitable(toEpochTimestamp(std::chrono::steady_clock::now() + timeout))
-    {}
-
     //! \brief Waits, at most, the given amount of time to determine whether
     //! the object is ready or not.
     //!
@@ -53,24 +52,119 @@ public:
     //! \return true if the object is ready and false otherwise.
     //!
     //! \throw #WaitableTimedOutException if not ready and deadline was exceeded.
+    //! \throw #WaitableCancelledException if the object's cancellation was requested.
     //!
-    //! \note Objects that inherit the TimedWaitable Interface should override
-    //! timedWait() to implement their specific waiting logic.
-    //!
-    //! \sa timedWait()
+    //! \sa TDerived::timedWait()
     bool wait(const std::chrono::microseconds& q) override final
     {
-        if (!expired(toEpochTimestamp(std::chrono::steady_clock::now()))) {
-            return timedWait(q);
+        return wait(q, toTimestamp(std::chrono::steady_clock::now()));
+    }
+
+    //! \brief Waits, at most, the given amount of time to determine whether
+    //! the object is ready or not, given the current time.
+    //!
+    //! \param q The maximum time to wait until determining whether the object
+    //! is ready or not.
+    //! \param timestamp The current timestamp used to check whether the
+    //! object's deadline was exceeded.
+    //!
+    //! \return true if the object is ready and false otherwise.
+    //!
+    //! \throw #WaitableTimedOutException if not ready and deadline was exceeded.
+    //! \throw #WaitableCancelledException if the object's cancellation was requested.
+    bool wait(const std::chrono::microseconds& q,
+              const std::chrono::nanoseconds& timestamp) override final
+    {
+        if (cancelled()) {
+            throw WaitableCancelledException("Wait cancelled");
         }
 
-        if (timedWait(std::chrono::microseconds(0))) {
+        auto& self = static_cast<TDerived&>(*this);
+
+        if (!expired(timestamp)) {
+            // No longer than the time left before the deadline, rounded up, so
+            // that the object is found expired by the next wait()
+            auto left = std::chrono::duration_cast<std::chrono::microseconds>(
+                timeout(timestamp) + std::chrono::nanoseconds(999)
+            );
+
+            return self.timedWait(std::min(q, left));
+        }
+
+        if (self.timedWait(std::chrono::microseconds(0))) {
             return true;
         }
 
         throw WaitableTimedOutException("Wait limit exceeded");
     }
 
+protected:
+    //! \brief Creates a Waitable object whose wait() method can throw a
+    //! #WaitableTimedOutException if the object is not ready and the
+    //! given timeout has passed. In those cases the object's expired
+    //! method should return true.
+    //!
+    //! \param timeout The timeout after which the object is considered
+    //! expired.
+    explicit StaticTimedWaitable(std::chrono::nanoseconds timeout) :
+        Waitable(toTimestamp(std::chrono::steady_clock::now()) + timeout)
+    {}
+
+    //! \brief Creates a Waitable object whose wait() method can throw a
+    //! #WaitableTimedOutException if the object is not ready and the
+    //! given deadline has passed.
+    //!
+    //! \param deadline The time point after which the object is considered
+    //! expired.
+    explicit StaticTimedWaitable(std::chrono::steady_clock::time_point deadline) :
+        Waitable(toTimestamp(deadline))
+    {}
+
+    std::chrono::microseconds getTimeout() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            timeout(toTimestamp(std::chrono::steady_clock::now())));
+    }
+
+    //! \brief Returns the object's deadline as a time point.
+    std::chrono::steady_clock::time_point getDeadline() const
+    {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(deadline()));
+    }
+};
+
+//! \brief A Waitable Interface to represent objects whose wait() method
+//! can throw a #WaitableTimedOutException if the object is not ready
+//! and the #Waitable object's deadline has been exceeded.
+//!
+//! \note Objects that inherit the TimedWaitable Interface should override
+//! timedWait() to implement their specific waiting logic.
+//!
+//! \sa StaticTimedWaitable
+class TimedWaitable : public StaticTimedWaitable<TimedWaitable> {
+public:
+    //! \brief Creates a Waitable object whose wait() method can throw a
+    //! #WaitableTimedOutException if the object is not ready and the
+    //! given timeout has passed. In those cases the object's expired
+    //! method should return true.
+    //!
+    //! \param timeout The timeout after which the object is considered
+    //! expired.
+    explicit TimedWaitable(std::chrono::nanoseconds timeout) :
+        StaticTimedWaitable(std::move(timeout))
+    {}
+
+    //! \brief Creates a Waitable object whose wait() method can throw a
+    //! #WaitableTimedOutException if the object is not ready and the
+    //! given deadline has passed.
+    //!
+    //! \param deadline The time point after which the object is considered
+    //! expired.
+    explicit TimedWaitable(std::chrono::steady_clock::time_point deadline) :
+        StaticTimedWaitable(std::move(deadline))
+    {}
+
     //! \brief Waits, at most, the given amount of time to determine whether
     //! the object is ready or not.
     //!
@@ -84,12 +178,6 @@ public:
     //! \note If timedWait() returns true, subsequent invocations of timedWait()
     //! should also return true as soon as possible.
     virtual bool timedWait(const std::chrono::microseconds& timeout) = 0;
-
-protected:
-    std::chrono::microseconds getTimeout() const
-    {
-        return timeout(toEpochTimestamp(std::chrono::steady_clock::now()));
-    }
 };
 
 } // namespace futures
@@ -0,0 +1,245 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include <thousandeyes/futures/Waitable.h>
+
+namespace thousandeyes {
+namespace futures {
+
+//! \brief The points in the lifetime of a #Waitable that executors trace.
+enum class TraceEvent {
+    //! The #Waitable was accepted by the executor.
+    Watched = 0,
+    //! The executor started waiting on the #Waitable.
+    PollBegin = 1,
+    //! The executor stopped waiting on the #Waitable.
+    PollEnd = 2,
+    //! The #Waitable was found ready (or failed) and is pending dispatch.
+    Ready = 3,
+    //! The dispatch() of the #Waitable, i.e., its continuation, started.
+    DispatchBegin = 4,
+    //! The dispatch() of the #Waitable, i.e., its continuation, returned.
+    DispatchEnd = 5
+};
+
+//! \brief A traced event of a #Waitable.
+struct TraceRecord {
+    TraceEvent event;
+
+    //! \brief The address of the #Waitable, which identifies it while it is alive.
+    const void* id;
+
+    //! \brief The time of the event in number of ns since the epoch of the
+    //! steady clock.
+    std::chrono::nanoseconds timestamp;
+
+    //! \brief The (small, process-wide) number of the thread that recorded the event.
+    std::uint32_t thread;
+};
+
+//! \brief An in-memory ring buffer of the events that executors record for the
+//! #Waitable objects that they watch.
+//!
+//! \par Once the buffer is full, the oldest records are overwritten, so that
+//! tracing can be left on in long-running processes. The records can be written
+//! in the JSON format of Chrome's trace viewer, which Perfetto also opens.
+//!
+//! \note Executors only record events if the library is compiled with
+//! THOUSANDEYES_FUTURES_TRACING defined; otherwise the tracing hooks compile
+//! to nothing.
+//!
+//! \sa PollingExecutor::setTracer()
+class Tracer {
+public:
+    //! \brief Creates a Tracer that keeps the given number of the latest records.
+    //!
+    //! \param capacity The maximum number of records to keep.
+    explicit Tracer(std::size_t capacity = 65536) :
+        records_(std::max<std::size_t>(capacity, 1))
+    {}
+
+    Tracer(const Tracer& o) = delete;
+    Tracer& operator=(const Tracer& o) = delete;
+
+    //! \brief Records the given event of the given #Waitable at the current time.
+    //!
+    //! \param event The event to record.
+    //! \param id The address of the #Waitable.
+    void record(TraceEvent event, const void* id)
+    {
+        auto timestamp = toTimestamp(std::chrono::steady_clock::now());
+        auto thread = threadNumber_();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        records_[count_ % records_.size()] = TraceRecord{ event, id, timestamp, thread };
+        ++count_;
+    }
+
+    //! \brief Returns the records kept in the buffer, oldest first.
+    std::vector<TraceRecord> records() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::vector<TraceRecord> result;
+        if (count_ <= records_.size()) {
+            result.assign(records_.begin(), records_.begin() + count_);
+        }
+        else {
+            auto oldest = records_.begin() + count_ % records_.size();
+            result.assign(oldest, records_.end());
+            result.insert(result.end(), records_.begin(), oldest);
+        }
+
+        return result;
+    }
+
+    //! \brief Returns the number of records that were overwritten.
+    std::size_t dropped() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_ > records_.size() ? count_ - records_.size() : 0;
+    }
+
+    //! \brief Discards all the records.
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        count_ = 0;
+    }
+
+    //! \brief Writes the records in the JSON format of Chrome's trace viewer.
+    //!
+    //! \par Each #Waitable becomes an asynchronous track with the consecutive
+    //! "pending" (watched until found ready), "queued" (found ready until
+    //! dispatched) and "dispatch" (its continuation) spans, while the polls and
+    //! the dispatches also appear as slices of the threads that ran them.
+    //!
+    //! \param os The stream to write to, e.g., a file opened by chrome://tracing
+    //! or https://ui.perfetto.dev afterwards.
+    void writeChromeTrace(std::ostream& os) const
+    {
+        auto trace = records();
+
+        os << "{\"traceEvents\":[";
+
+        bool isFirst = true;
+        auto write = [&os, &isFirst](const TraceRecord& r, const char* name, char phase) {
+            os << (isFirst ? "\n" : ",\n");
+            isFirst = false;
+
+            auto ns = r.timestamp.count();
+            auto fraction = ns % 1000;
+
+            os << "{\"name\":\"" << name << "\",\"cat\":\"waitable\",\"ph\":\"" << phase
+               << "\",\"ts\":" << ns / 1000 << '.'
+               << (fraction < 100 ? "0" : "") << (fraction < 10 ? "0" : "") << fraction
+               << ",\"pid\":1,\"tid\":" << r.thread
+               << ",\"id\":\"0x" << std::hex << reinterpret_cast<std::uintptr_t>(r.id)
+               << std::dec << "\"}";
+        };
+
+        for (const TraceRecord& r: trace) {
+            switch (r.event) {
+            case TraceEvent::Watched:
+                write(r, "pending", 'b');
+                break;
+            case TraceEvent::PollBegin:
+                write(r, "poll", 'B');
+                break;
+            case TraceEvent::PollEnd:
+                write(r, "poll", 'E');
+                break;
+            case TraceEvent::Ready:
+                write(r, "pending", 'e');
+                write(r, "queued", 'b');
+                break;
+            case TraceEvent::DispatchBegin:
+                write(r, "queued", 'e');
+                write(r, "dispatch", 'b');
+                write(r, "dispatch", 'B');
+                break;
+            case TraceEvent::DispatchEnd:
+                write(r, "dispatch", 'E');
+                write(r, "dispatch", 'e');
+                break;
+            }
+        }
+
+        os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    }
+
+private:
+    static std::uint32_t threadNumber_()
+    {
+        static std::atomic<std::uint32_t> count{ 0 };
+        static thread_local std::uint32_t number = ++count;
+        return number;
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<TraceRecord> records_;
+    std::size_t count_{ 0 };
+};
+
+namespace detail {
+
+//! \brief The handle through which executors record events to their #Tracer.
+//!
+//! \note Without THOUSANDEYES_FUTURES_TRACING, the handle is empty and recording
+//! does nothing, so that the calls are optimized away.
+#ifdef THOUSANDEYES_FUTURES_TRACING
+class TraceHandle {
+public:
+    TraceHandle() = default;
+
+    explicit TraceHandle(std::shared_ptr<Tracer> tracer) :
+        tracer_(std::move(tracer))
+    {}
+
+    inline void operator()(TraceEvent event, const void* id) const
+    {
+        if (tracer_) {
+            tracer_->record(event, id);
+        }
+    }
+
+private:
+    std::shared_ptr<Tracer> tracer_;
+};
+#else
+class TraceHandle {
+public:
+    TraceHandle() = default;
+
+    explicit TraceHandle(std::shared_ptr<Tracer> /* tracer */)
+    {}
+
+    inline void operator()(TraceEvent /* event */, const void* /* id */) const
+    {}
+};
+#endif
+
+} // namespace detail
+
+} // namespace futures
+} // namespace thousandeyes
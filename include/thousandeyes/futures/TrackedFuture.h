@@ -0,0 +1,265 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <thousandeyes/futures/CancellationToken.h>
+#include <thousandeyes/futures/Default.h>
+#include <thousandeyes/futures/Executor.h>
+#include <thousandeyes/futures/then.h>
+
+namespace thousandeyes {
+namespace futures {
+
+//! \brief A future that cancels the work producing its value when it is
+//! abandoned.
+//!
+//! \par A TrackedFuture wraps the std::future returned by then() together with
+//! the #CancellationSource of the continuation's #Waitable. If the TrackedFuture is
+//! destroyed before its value is retrieved, the source is cancelled and the executor
+//! discards the orphaned #Waitable instead of polling it until its time limit.
+//!
+//! \note The shared state of an std::future cannot be observed by the library, so
+//! only abandoning the TrackedFuture itself is detected; the std::future obtained
+//! by release() is no longer tracked.
+//!
+//! \sa thenTracked(), CancellationSource
+template<class T>
+class TrackedFuture {
+public:
+    TrackedFuture() = default;
+
+    //! \brief Creates a TrackedFuture that cancels the given source when abandoned.
+    //!
+    //! \param f The future to track.
+    //! \param source The source associated with the work producing f's value.
+    TrackedFuture(std::future<T> f, CancellationSource source) :
+        f_(std::move(f))
+    {
+        sources_.push_back(std::move(source));
+    }
+
+    ~TrackedFuture()
+    {
+        if (f_.valid()) {
+            cancel();
+        }
+    }
+
+    TrackedFuture(const TrackedFuture& o) = delete;
+    TrackedFuture& operator=(const TrackedFuture& o) = delete;
+
+    TrackedFuture(TrackedFuture&& o) = default;
+
+    TrackedFuture& operator=(TrackedFuture&& o)
+    {
+        if (this != &o) {
+            if (f_.valid()) {
+                cancel();
+            }
+
+            f_ = std::move(o.f_);
+            sources_ = std::move(o.sources_);
+        }
+
+        return *this;
+    }
+
+    //! \brief Waits for the value and retrieves it.
+    //!
+    //! \note Once the value is retrieved, the future is no longer tracked.
+    T get()
+    {
+        sources_.clear();
+        return f_.get();
+    }
+
+    //! \brief Checks whether the object refers to a shared state.
+    bool valid() const
+    {
+        return f_.valid();
+    }
+
+    //! \brief Waits for the value to become available.
+    void wait() const
+    {
+        f_.wait();
+    }
+
+    //! \brief Waits, at most, the given amount of time for the value to become available.
+    template<class TRep, class TPeriod>
+    std::future_status wait_for(const std::chrono::duration<TRep, TPeriod>& timeout) const
+    {
+        return f_.wait_for(timeout);
+    }
+
+    //! \brief Requests the cancellation of the work producing the value.
+    //!
+    //! \note The future becomes ready with a #WaitableCancelledException unless its
+    //! value is already available.
+    void cancel()
+    {
+        for (CancellationSource& source: sources_) {
+            source.cancel();
+        }
+        sources_.clear();
+    }
+
+    //! \brief Stops tracking and returns the wrapped future.
+    //!
+    //! \note The work producing the value is no longer cancelled if the returned
+    //! future is abandoned.
+    std::future<T> release()
+    {
+        sources_.clear();
+        return std::move(f_);
+    }
+
+private:
+    template<class TIn, class TFunc>
+    friend auto thenTracked(std::shared_ptr<Executor> executor,
+                            std::chrono::nanoseconds timeLimit,
+                            TrackedFuture<TIn> f,
+                            TFunc&& cont);
+
+    std::future<T> f_;
+    std::vector<CancellationSource> sources_;
+};
+
+//! \brief Creates a tracked future that becomes ready when the input future
+//! becomes ready.
+//!
+//! \par Same as then() but the resulting #TrackedFuture discards the continuation
+//! when it is abandoned before becoming ready.
+//!
+//! \param executor The object that waits for the given future to become ready.
+//! \param timeLimit The maximum time to wait for the given future to become ready.
+//! \param f The input future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \sa then(), TrackedFuture
+//!
+//! \return A #TrackedFuture that contains the value returned by the given
+//! continuation function (or by the future that it returns).
+template<class TIn, class TFunc>
+auto thenTracked(std::shared_ptr<Executor> executor,
+                 std::chrono::nanoseconds timeLimit,
+                 std::future<TIn> f,
+                 TFunc&& cont)
+{
+    CancellationSource source;
+
+    auto result = then<TIn, TFunc>(std::move(executor),
+                                   Priority::Normal,
+                                   source.token(),
+                                   std::move(timeLimit),
+                                   std::move(f),
+                                   std::forward<TFunc>(cont));
+
+    using TOut = typename std::decay<decltype(result.get())>::type;
+
+    return TrackedFuture<TOut>(std::move(result), std::move(source));
+}
+
+//! \brief Creates a tracked future that becomes ready when the input tracked
+//! future becomes ready.
+//!
+//! \par Abandoning the resulting #TrackedFuture discards both the continuation
+//! and the work producing the input future, so that whole orphaned chains are
+//! discarded.
+//!
+//! \param executor The object that waits for the given future to become ready.
+//! \param timeLimit The maximum time to wait for the given future to become ready.
+//! \param f The input future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \sa then(), TrackedFuture
+//!
+//! \return A #TrackedFuture that contains the value returned by the given
+//! continuation function (or by the future that it returns).
+template<class TIn, class TFunc>
+auto thenTracked(std::shared_ptr<Executor> executor,
+                 std::chrono::nanoseconds timeLimit,
+                 TrackedFuture<TIn> f,
+                 TFunc&& cont)
+{
+    auto sources = std::move(f.sources_);
+
+    auto result = thenTracked<TIn, TFunc>(std::move(executor),
+                                          std::move(timeLimit),
+                                          std::move(f.f_),
+                                          std::forward<TFunc>(cont));
+
+    for (CancellationSource& source: sources) {
+        result.sources_.push_back(std::move(source));
+    }
+
+    return result;
+}
+
+//! \brief Creates a tracked future that becomes ready when the input future
+//! becomes ready.
+//!
+//! \par Same as then() but the resulting #TrackedFuture discards the continuation
+//! when it is abandoned before becoming ready.
+//!
+//! \param executor The object that waits for the given future to become ready.
+//! \param f The input future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the input future to become ready exceeds
+//! a maximum threshold defined by the library (typically 1h), the resulting future
+//! becomes ready with an exception of type WaitableTimedOutException.
+//!
+//! \sa then(), TrackedFuture
+//!
+//! \return A #TrackedFuture that contains the value returned by the given
+//! continuation function (or by the future that it returns).
+template<class TFuture, class TFunc>
+auto thenTracked(std::shared_ptr<Executor> executor, TFuture f, TFunc&& cont)
+{
+    return thenTracked(std::move(executor),
+                       std::chrono::hours(1),
+                       std::move(f),
+                       std::forward<TFunc>(cont));
+}
+
+//! \brief Creates a tracked future that becomes ready when the input future
+//! becomes ready.
+//!
+//! \par Same as then() but the resulting #TrackedFuture discards the continuation
+//! when it is abandoned before becoming ready. This function uses the default
+//! Executor object to wait for the given future to become ready.
+//!
+//! \param f The input future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \sa then(), Default, TrackedFuture
+//!
+//! \return A #TrackedFuture that contains the value returned by the given
+//! continuation function (or by the future that it returns).
+template<class TFuture, class TFunc>
+auto thenTracked(TFuture f, TFunc&& cont)
+{
+    return thenTracked(Default<Executor>(),
+                       std::chrono::hours(1),
+                       std::move(f),
+                       std::forward<TFunc>(cont));
+}
+
+} // namespace futures
+} // namespace thousandeyes
@@ -12,8 +12,12 @@
 
 #include <chrono>
 #include <exception>
+#include <stdexcept>
+#include <string>
 #include <utility>
 
+#include <thousandeyes/futures/CancellationToken.h>
+
 namespace thousandeyes {
 namespace futures {
 
@@ -27,17 +31,52 @@ public:
     {}
 };
 
+//! \brief Exception used to dispatch Waitable objects whose cancellation
+//! was requested.
+//!
+//! \sa Waitable, CancellationSource
+class WaitableCancelledException : public WaitableWaitException {
+public:
+    explicit WaitableCancelledException(const std::string& reason) :
+        WaitableWaitException(reason)
+    {}
+};
+
 //! \brief Utility function to convert a time-point to an epoch timestamp.
 //!
 //! \param t The timepoint to convert to an epoch timestamp.
 //!
 //! \returns the time of milliseconds since the Epoch.
+//!
+//! \note #Waitable deadlines are expressed with toTimestamp(), which
+//! keeps the full resolution of the clock.
 template<class TClock, class TDuration>
 std::chrono::milliseconds toEpochTimestamp(const std::chrono::time_point<TClock, TDuration>& t)
 {
     return std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch());
 }
 
+//! \brief Utility function to convert a steady clock time-point to a
+//! #Waitable timestamp.
+//!
+//! \param t The timepoint to convert to a timestamp.
+//!
+//! \returns the time of nanoseconds since the epoch of the steady clock.
+inline std::chrono::nanoseconds toTimestamp(const std::chrono::steady_clock::time_point& t)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch());
+}
+
+//! \brief The priority class of a #Waitable.
+//!
+//! \note Executors that support priorities poll and dispatch #Waitable objects
+//! of higher priority classes first.
+enum class Priority {
+    Low = 0,
+    Normal = 1,
+    High = 2
+};
+
 //! \brief Interface to represent objects that can be waited on,
 //! ordered by deadline, expire and, finally, get dispatched.
 class Waitable {
@@ -45,9 +84,11 @@ public:
     //! \brief Creates a Waitable object with the given deadline.
     //!
     //! \param deadline The deadline after which the object is considered
-    //! expired in number of ms since the Epoch.
-    explicit Waitable(std::chrono::milliseconds epochDeadline) :
-        epochDeadline_(std::move(epochDeadline))
+    //! expired in number of ns since the epoch of the steady clock.
+    //!
+    //! \sa toTimestamp()
+    explicit Waitable(std::chrono::nanoseconds deadline) :
+        deadline_(std::move(deadline))
     {}
 
     Waitable() = default;
@@ -68,6 +109,26 @@ public:
     //! also return true as soon as possible.
     virtual bool wait(const std::chrono::microseconds& q) = 0;
 
+    //! \brief Waits, at most, the given amount of time to determine whether
+    //! the object is ready or not, given the current time.
+    //!
+    //! \param q The maximum time to wait until determining whether the object
+    //! is ready or not.
+    //! \param timestamp The current timestamp in number of ns since the epoch of
+    //! the steady clock, as read by the caller (e.g., once per polling sweep).
+    //!
+    //! \return true if the object is ready and false otherwise.
+    //!
+    //! \throw #WaitableWaitException if an error occurs at/during waiting.
+    //!
+    //! \note The default implementation ignores the given timestamp and invokes
+    //! wait(q), so that existing implementations keep working.
+    virtual bool wait(const std::chrono::microseconds& q,
+                      const std::chrono::nanoseconds& /* timestamp */)
+    {
+        return wait(q);
+    }
+
     //! \brief Dispatches the object, setting it to a finished state.
     //!
     //! \note Once the object is set to the "finished" state, no other method of the
@@ -82,33 +143,81 @@ public:
     //! \returns < 0 if the current object has a shorter deadline, > 0
     //! if the current object has a longer deadline and = 0 if the
     //! deadlines are equal.
-    inline std::chrono::milliseconds compare(const Waitable& other) const
+    inline std::chrono::nanoseconds compare(const Waitable& other) const
     {
-        return epochDeadline_ - other.epochDeadline_;
+        return deadline_ - other.deadline_;
     }
 
     //! \brief Returns the current object's timeout with respect to the given timestamp.
     //!
-    //! \param epochTimestamp The current timestamp in number of ms since the Epoch.
+    //! \param timestamp The current timestamp in number of ns since the epoch of
+    //! the steady clock.
     //!
-    //! \return the milliseconds until the object's deadline exceeds the given timestamp.
-    inline std::chrono::milliseconds timeout(const std::chrono::milliseconds& epochTimestamp) const
+    //! \return the nanoseconds until the object's deadline exceeds the given timestamp.
+    inline std::chrono::nanoseconds timeout(const std::chrono::nanoseconds& timestamp) const
+    {
+        return deadline_ - timestamp;
+    }
+
+    //! \brief Returns the object's deadline in number of ns since the epoch of
+    //! the steady clock.
+    inline const std::chrono::nanoseconds& deadline() const
     {
-        return epochDeadline_ - epochTimestamp;
+        return deadline_;
     }
 
     //! \brief Checks whether the object's deadline has been exceeded.
     //!
-    //! \param epochTimestamp The current timestamp in number of ms since the Epoch.
+    //! \param timestamp The current timestamp in number of ns since the epoch of
+    //! the steady clock.
     //!
     //! \return true if the object's deadline has been exceeded and false otherwise.
-    inline bool expired(const std::chrono::milliseconds& epochTimestamp) const
+    inline bool expired(const std::chrono::nanoseconds& timestamp) const
+    {
+        return timestamp >= deadline_;
+    }
+
+    //! \brief Returns the priority class of the object.
+    inline Priority priority() const
+    {
+        return priority_;
+    }
+
+    //! \brief Sets the priority class of the object.
+    //!
+    //! \param priority The priority class that executors should take into account.
+    inline void setPriority(Priority priority)
+    {
+        priority_ = priority;
+    }
+
+    //! \brief Returns the cancellation token of the object.
+    inline const CancellationToken& cancellationToken() const
+    {
+        return cancellationToken_;
+    }
+
+    //! \brief Sets the cancellation token of the object.
+    //!
+    //! \param token The token that executors check to drop the object early.
+    inline void setCancellationToken(CancellationToken token)
+    {
+        cancellationToken_ = std::move(token);
+    }
+
+    //! \brief Checks whether the cancellation of the object has been requested.
+    //!
+    //! \note Executors should dispatch cancelled objects, without waiting on them,
+    //! with a #WaitableCancelledException.
+    inline bool cancelled() const
     {
-        return epochTimestamp >= epochDeadline_;
+        return cancellationToken_.cancelled();
     }
 
 private:
-    std::chrono::milliseconds epochDeadline_{ 0 };
+    std::chrono::nanoseconds deadline_{ 0 };
+    Priority priority_{ Priority::Normal };
+    CancellationToken cancellationToken_;
 };
 
 } // namespace futures
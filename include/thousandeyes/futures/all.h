@@ -15,9 +15,11 @@
 #include <memory>
 #include <type_traits>
 #include <tuple>
+#include <vector>
 
 #include <thousandeyes/futures/detail/FutureWithContainer.h>
 #include <thousandeyes/futures/detail/FutureWithTuple.h>
+#include <thousandeyes/futures/detail/FutureWithValues.h>
 #include <thousandeyes/futures/detail/FutureWithIterators.h>
 #include <thousandeyes/futures/detail/typetraits.h>
 
@@ -33,6 +35,8 @@ namespace futures {
 //! container become ready.
 //!
 //! \param executor The object that waits for the given futures to become ready.
+//! \param priority The priority class used by the executor for the input futures.
+//! \param token The token used to cancel waiting for the input futures.
 //! \param timeLimit The maximum time to wait for all the given futures to become ready.
 //! \param futures The container that contains all the input futures.
 //!
@@ -40,28 +44,133 @@ namespace futures {
 //! given timeLimit, the resulting future becomes ready with an exception of type
 //! WaitableTimedOutException.
 //!
-//! \sa WaitableTimedOutException
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa Priority, CancellationToken, WaitableTimedOutException, WaitableCancelledException
 //!
 //! \return An std::future<TContainer> that contains all the input futures, where
 //! all the contained futures are ready.
 template<class TContainer>
 std::future<typename std::decay<TContainer>::type> all(std::shared_ptr<Executor> executor,
-                                                       std::chrono::microseconds timeLimit,
+                                                       Priority priority,
+                                                       CancellationToken token,
+                                                       std::chrono::nanoseconds timeLimit,
                                                        TContainer&& futures)
 {
     std::promise<typename std::decay<TContainer>::type> p;
 
     auto result = p.get_future();
 
-    executor->watch(std::make_unique<detail::FutureWithContainer<TContainer>>(
+    auto w = std::make_unique<detail::FutureWithContainer<TContainer>>(
         std::move(timeLimit),
         std::forward<TContainer>(futures),
         std::move(p)
-    ));
+    );
+
+    w->setPriority(priority);
+    w->setCancellationToken(std::move(token));
+
+    executor->watch(std::move(w));
 
     return result;
 }
 
+//! \brief Creates a future that becomes ready when all the input futures become ready.
+//!
+//! \par The resulting future becomes ready when all the futures in the given
+//! container become ready.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param priority The priority class used by the executor for the input futures.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param futures The container that contains all the input futures.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa Priority, WaitableTimedOutException
+//!
+//! \return An std::future<TContainer> that contains all the input futures, where
+//! all the contained futures are ready.
+template<class TContainer>
+std::future<typename std::decay<TContainer>::type> all(std::shared_ptr<Executor> executor,
+                                                       Priority priority,
+                                                       std::chrono::nanoseconds timeLimit,
+                                                       TContainer&& futures)
+{
+    return all<TContainer>(std::move(executor),
+                           priority,
+                           CancellationToken(),
+                           std::move(timeLimit),
+                           std::forward<TContainer>(futures));
+}
+
+//! \brief Creates a future that becomes ready when all the input futures become ready.
+//!
+//! \par The resulting future becomes ready when all the futures in the given
+//! container become ready.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param token The token used to cancel waiting for the input futures.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param futures The container that contains all the input futures.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa CancellationToken, WaitableTimedOutException, WaitableCancelledException
+//!
+//! \return An std::future<TContainer> that contains all the input futures, where
+//! all the contained futures are ready.
+template<class TContainer>
+std::future<typename std::decay<TContainer>::type> all(std::shared_ptr<Executor> executor,
+                                                       CancellationToken token,
+                                                       std::chrono::nanoseconds timeLimit,
+                                                       TContainer&& futures)
+{
+    return all<TContainer>(std::move(executor),
+                           Priority::Normal,
+                           std::move(token),
+                           std::move(timeLimit),
+                           std::forward<TContainer>(futures));
+}
+
+//! \brief Creates a future that becomes ready when all the input futures become ready.
+//!
+//! \par The resulting future becomes ready when all the futures in the given
+//! container become ready.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param futures The container that contains all the input futures.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa WaitableTimedOutException
+//!
+//! \return An std::future<TContainer> that contains all the input futures, where
+//! all the contained futures are ready.
+template<class TContainer>
+std::future<typename std::decay<TContainer>::type> all(std::shared_ptr<Executor> executor,
+                                                       std::chrono::nanoseconds timeLimit,
+                                                       TContainer&& futures)
+{
+    return all<TContainer>(std::move(executor),
+                           Priority::Normal,
+                           std::move(timeLimit),
+                           std::forward<TContainer>(futures));
+}
+
 //! \brief Creates a future that becomes ready when all the input futures become ready.
 //!
 //! \par The resulting future becomes ready when all the futures in the given
@@ -106,7 +215,7 @@ std::future<typename std::decay<TContainer>::type> all(std::shared_ptr<Executor>
 //! \return An std::future<TContainer> that contains all the input futures, where
 //! all the contained futures are ready.
 template<class TContainer>
-std::future<typename std::decay<TContainer>::type> all(std::chrono::microseconds timeLimit,
+std::future<typename std::decay<TContainer>::type> all(std::chrono::nanoseconds timeLimit,
                                                        TContainer&& futures)
 {
     return all<TContainer>(Default<Executor>(),
@@ -144,6 +253,8 @@ std::future<typename std::decay<TContainer>::type> all(TContainer&& futures)
 //! tuple become ready.
 //!
 //! \param executor The object that waits for the given futures to become ready.
+//! \param priority The priority class used by the executor for the input futures.
+//! \param token The token used to cancel waiting for the input futures.
 //! \param timeLimit The maximum time to wait for all the given futures to become ready.
 //! \param futures The input futures as a tuple.
 //!
@@ -151,28 +262,133 @@ std::future<typename std::decay<TContainer>::type> all(TContainer&& futures)
 //! given timeLimit, the resulting future becomes ready with an exception of type
 //! WaitableTimedOutException.
 //!
-//! \sa WaitableTimedOutException
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa Priority, CancellationToken, WaitableTimedOutException, WaitableCancelledException
 //!
 //! \return An std::future<std::tuple> that contains all the input futures, where
 //! all the contained futures are ready.
 template<typename... Args>
 std::future<std::tuple<std::future<Args>...>> all(std::shared_ptr<Executor> executor,
-                                                  std::chrono::microseconds timeLimit,
+                                                  Priority priority,
+                                                  CancellationToken token,
+                                                  std::chrono::nanoseconds timeLimit,
                                                   std::tuple<std::future<Args>...> futures)
 {
     std::promise<std::tuple<std::future<Args>...>> p;
 
     auto result = p.get_future();
 
-    executor->watch(std::make_unique<detail::FutureWithTuple<Args...>>(
+    auto w = std::make_unique<detail::FutureWithTuple<Args...>>(
         std::move(timeLimit),
         std::move(futures),
         std::move(p)
-    ));
+    );
+
+    w->setPriority(priority);
+    w->setCancellationToken(std::move(token));
+
+    executor->watch(std::move(w));
 
     return result;
 }
 
+//! \brief Creates a future that becomes ready when all the input futures become ready.
+//!
+//! \par The resulting future becomes ready when all the futures in the given
+//! tuple become ready.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param priority The priority class used by the executor for the input futures.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param futures The input futures as a tuple.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa Priority, WaitableTimedOutException
+//!
+//! \return An std::future<std::tuple> that contains all the input futures, where
+//! all the contained futures are ready.
+template<typename... Args>
+std::future<std::tuple<std::future<Args>...>> all(std::shared_ptr<Executor> executor,
+                                                  Priority priority,
+                                                  std::chrono::nanoseconds timeLimit,
+                                                  std::tuple<std::future<Args>...> futures)
+{
+    return all<Args...>(std::move(executor),
+                        priority,
+                        CancellationToken(),
+                        std::move(timeLimit),
+                        std::move(futures));
+}
+
+//! \brief Creates a future that becomes ready when all the input futures become ready.
+//!
+//! \par The resulting future becomes ready when all the futures in the given
+//! tuple become ready.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param token The token used to cancel waiting for the input futures.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param futures The input futures as a tuple.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa CancellationToken, WaitableTimedOutException, WaitableCancelledException
+//!
+//! \return An std::future<std::tuple> that contains all the input futures, where
+//! all the contained futures are ready.
+template<typename... Args>
+std::future<std::tuple<std::future<Args>...>> all(std::shared_ptr<Executor> executor,
+                                                  CancellationToken token,
+                                                  std::chrono::nanoseconds timeLimit,
+                                                  std::tuple<std::future<Args>...> futures)
+{
+    return all<Args...>(std::move(executor),
+                        Priority::Normal,
+                        std::move(token),
+                        std::move(timeLimit),
+                        std::move(futures));
+}
+
+//! \brief Creates a future that becomes ready when all the input futures become ready.
+//!
+//! \par The resulting future becomes ready when all the futures in the given
+//! tuple become ready.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param futures The input futures as a tuple.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa WaitableTimedOutException
+//!
+//! \return An std::future<std::tuple> that contains all the input futures, where
+//! all the contained futures are ready.
+template<typename... Args>
+std::future<std::tuple<std::future<Args>...>> all(std::shared_ptr<Executor> executor,
+                                                  std::chrono::nanoseconds timeLimit,
+                                                  std::tuple<std::future<Args>...> futures)
+{
+    return all<Args...>(std::move(executor),
+                        Priority::Normal,
+                        std::move(timeLimit),
+                        std::move(futures));
+}
+
 //! \brief Creates a future that becomes ready when all the input futures become ready.
 //!
 //! \par The resulting future becomes ready when all the futures in the given
@@ -217,7 +433,7 @@ std::future<std::tuple<std::future<Args>...>> all(std::shared_ptr<Executor> exec
 //! \return An std::future<std::tuple> that contains all the input futures, where
 //! all the contained futures are ready.
 template<typename... Args>
-std::future<std::tuple<std::future<Args>...>> all(std::chrono::microseconds timeLimit,
+std::future<std::tuple<std::future<Args>...>> all(std::chrono::nanoseconds timeLimit,
                                                   std::tuple<std::future<Args>...> futures)
 {
     return all<Args...>(Default<Executor>(),
@@ -255,6 +471,8 @@ std::future<std::tuple<std::future<Args>...>> all(std::tuple<std::future<Args>..
 //! arguments become ready.
 //!
 //! \param executor The object that waits for the given futures to become ready.
+//! \param priority The priority class used by the executor for the input futures.
+//! \param token The token used to cancel waiting for the input futures.
 //! \param timeLimit The maximum time to wait for all the given futures to become ready.
 //! \param futures... The input futures as variable arguments.
 //!
@@ -262,14 +480,20 @@ std::future<std::tuple<std::future<Args>...>> all(std::tuple<std::future<Args>..
 //! given timeLimit, the resulting future becomes ready with an exception of type
 //! WaitableTimedOutException.
 //!
-//! \sa WaitableTimedOutException
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa Priority, CancellationToken, WaitableTimedOutException, WaitableCancelledException
 //!
 //! \return An std::future<std::tuple> that contains all the input futures, where
 //! all the contained futures are ready.
 template<typename Arg, typename... Args>
 std::future<std::tuple<std::future<Arg>, std::future<Args>...>> all(
     std::shared_ptr<Executor> executor,
-    std::chrono::microseconds timeLimit,
+    Priority priority,
+    CancellationToken token,
+    std::chrono::nanoseconds timeLimit,
     std::future<Arg> future,
     std::future<Args>... futures
 )
@@ -277,10 +501,118 @@ std::future<std::tuple<std::future<Arg>, std::future<Args>...>> all(
     using Tuple = std::tuple<std::future<Arg>, std::future<Args>...>;
 
     return all<Arg, Args...>(executor,
+                             priority,
+                             std::move(token),
                              std::move(timeLimit),
                              Tuple{ std::move(future), std::move(futures)... });
 }
 
+//! \brief Creates a future that becomes ready when all the input futures become ready.
+//!
+//! \par The resulting future becomes ready when all the futures given as
+//! arguments become ready.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param priority The priority class used by the executor for the input futures.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param futures... The input futures as variable arguments.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa Priority, WaitableTimedOutException
+//!
+//! \return An std::future<std::tuple> that contains all the input futures, where
+//! all the contained futures are ready.
+template<typename Arg, typename... Args>
+std::future<std::tuple<std::future<Arg>, std::future<Args>...>> all(
+    std::shared_ptr<Executor> executor,
+    Priority priority,
+    std::chrono::nanoseconds timeLimit,
+    std::future<Arg> future,
+    std::future<Args>... futures
+)
+{
+    return all<Arg, Args...>(std::move(executor),
+                             priority,
+                             CancellationToken(),
+                             std::move(timeLimit),
+                             std::move(future),
+                             std::move(futures)...);
+}
+
+//! \brief Creates a future that becomes ready when all the input futures become ready.
+//!
+//! \par The resulting future becomes ready when all the futures given as
+//! arguments become ready.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param token The token used to cancel waiting for the input futures.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param futures... The input futures as variable arguments.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa CancellationToken, WaitableTimedOutException, WaitableCancelledException
+//!
+//! \return An std::future<std::tuple> that contains all the input futures, where
+//! all the contained futures are ready.
+template<typename Arg, typename... Args>
+std::future<std::tuple<std::future<Arg>, std::future<Args>...>> all(
+    std::shared_ptr<Executor> executor,
+    CancellationToken token,
+    std::chrono::nanoseconds timeLimit,
+    std::future<Arg> future,
+    std::future<Args>... futures
+)
+{
+    return all<Arg, Args...>(std::move(executor),
+                             Priority::Normal,
+                             std::move(token),
+                             std::move(timeLimit),
+                             std::move(future),
+                             std::move(futures)...);
+}
+
+//! \brief Creates a future that becomes ready when all the input futures become ready.
+//!
+//! \par The resulting future becomes ready when all the futures given as
+//! arguments become ready.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param futures... The input futures as variable arguments.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa WaitableTimedOutException
+//!
+//! \return An std::future<std::tuple> that contains all the input futures, where
+//! all the contained futures are ready.
+template<typename Arg, typename... Args>
+std::future<std::tuple<std::future<Arg>, std::future<Args>...>> all(
+    std::shared_ptr<Executor> executor,
+    std::chrono::nanoseconds timeLimit,
+    std::future<Arg> future,
+    std::future<Args>... futures
+)
+{
+    return all<Arg, Args...>(std::move(executor),
+                             Priority::Normal,
+                             std::move(timeLimit),
+                             std::move(future),
+                             std::move(futures)...);
+}
+
 //! \brief Creates a future that becomes ready when all the input futures become ready.
 //!
 //! \par The resulting future becomes ready when all the futures given as
@@ -329,7 +661,7 @@ std::future<std::tuple<std::future<Arg>, std::future<Args>...>> all(
 //! \return An std::future<std::tuple> that contains all the input futures, where
 //! all the contained futures are ready.
 template<typename Arg, typename... Args>
-std::future<std::tuple<std::future<Arg>, std::future<Args>...>> all(std::chrono::microseconds timeLimit,
+std::future<std::tuple<std::future<Arg>, std::future<Args>...>> all(std::chrono::nanoseconds timeLimit,
                                                                     std::future<Arg> future,
                                                                     std::future<Args>... futures)
 {
@@ -383,6 +715,8 @@ using all_accepts_fwd_iterator_t =
 //! [first, last) become ready.
 //!
 //! \param executor The object that waits for the given futures to become ready.
+//! \param priority The priority class used by the executor for the input futures.
+//! \param token The token used to cancel waiting for the input futures.
 //! \param timeLimit The maximum time to wait for all the given futures to become ready.
 //! \param first The first ForwardIterator of the range [first, last).
 //! \param last A ForwardIterator that marks the end of the range [first, last).
@@ -396,13 +730,19 @@ using all_accepts_fwd_iterator_t =
 //! all the results from the futures in [first, last) or until the continuations
 //! attached to the resulting future, using then(), finish processing.
 //!
-//! \sa then(), WaitableTimedOutException
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa Priority, CancellationToken, then(), WaitableTimedOutException, WaitableCancelledException
 //!
 //! \return A std::future<std::tuple> with the input ForwardIterators, where all the
 //! futures in range [first, last) are ready.
 template<class TForwardIterator>
 all_accepts_fwd_iterator_t<TForwardIterator> all(std::shared_ptr<Executor> executor,
-                                                 std::chrono::microseconds timeLimit,
+                                                 Priority priority,
+                                                 CancellationToken token,
+                                                 std::chrono::nanoseconds timeLimit,
                                                  TForwardIterator first,
                                                  TForwardIterator last)
 {
@@ -410,16 +750,139 @@ all_accepts_fwd_iterator_t<TForwardIterator> all(std::shared_ptr<Executor> execu
 
     auto result = p.get_future();
 
-    executor->watch(std::make_unique<detail::FutureWithIterators<TForwardIterator>>(
+    auto w = std::make_unique<detail::FutureWithIterators<TForwardIterator>>(
         std::move(timeLimit),
         first,
         last,
         std::move(p)
-    ));
+    );
+
+    w->setPriority(priority);
+    w->setCancellationToken(std::move(token));
+
+    executor->watch(std::move(w));
 
     return result;
 }
 
+//! \brief Creates a future that becomes ready when all the input futures become ready.
+//!
+//! \par The resulting future becomes ready when all the futures in range
+//! [first, last) become ready.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param priority The priority class used by the executor for the input futures.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param first The first ForwardIterator of the range [first, last).
+//! \param last A ForwardIterator that marks the end of the range [first, last).
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \note The original containers, from which first and last are obtained, have to stay
+//! alive and stable (in the same memory address) until the client code finishes extracting
+//! all the results from the futures in [first, last) or until the continuations
+//! attached to the resulting future, using then(), finish processing.
+//!
+//! \sa Priority, then(), WaitableTimedOutException
+//!
+//! \return A std::future<std::tuple> with the input ForwardIterators, where all the
+//! futures in range [first, last) are ready.
+template<class TForwardIterator>
+all_accepts_fwd_iterator_t<TForwardIterator> all(std::shared_ptr<Executor> executor,
+                                                 Priority priority,
+                                                 std::chrono::nanoseconds timeLimit,
+                                                 TForwardIterator first,
+                                                 TForwardIterator last)
+{
+    return all<TForwardIterator>(std::move(executor),
+                                 priority,
+                                 CancellationToken(),
+                                 std::move(timeLimit),
+                                 first,
+                                 last);
+}
+
+//! \brief Creates a future that becomes ready when all the input futures become ready.
+//!
+//! \par The resulting future becomes ready when all the futures in range
+//! [first, last) become ready.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param token The token used to cancel waiting for the input futures.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param first The first ForwardIterator of the range [first, last).
+//! \param last A ForwardIterator that marks the end of the range [first, last).
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \note The original containers, from which first and last are obtained, have to stay
+//! alive and stable (in the same memory address) until the client code finishes extracting
+//! all the results from the futures in [first, last) or until the continuations
+//! attached to the resulting future, using then(), finish processing.
+//!
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa CancellationToken, then(), WaitableTimedOutException, WaitableCancelledException
+//!
+//! \return A std::future<std::tuple> with the input ForwardIterators, where all the
+//! futures in range [first, last) are ready.
+template<class TForwardIterator>
+all_accepts_fwd_iterator_t<TForwardIterator> all(std::shared_ptr<Executor> executor,
+                                                 CancellationToken token,
+                                                 std::chrono::nanoseconds timeLimit,
+                                                 TForwardIterator first,
+                                                 TForwardIterator last)
+{
+    return all<TForwardIterator>(std::move(executor),
+                                 Priority::Normal,
+                                 std::move(token),
+                                 std::move(timeLimit),
+                                 first,
+                                 last);
+}
+
+//! \brief Creates a future that becomes ready when all the input futures become ready.
+//!
+//! \par The resulting future becomes ready when all the futures in range
+//! [first, last) become ready.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param first The first ForwardIterator of the range [first, last).
+//! \param last A ForwardIterator that marks the end of the range [first, last).
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \note The original containers, from which first and last are obtained, have to stay
+//! alive and stable (in the same memory address) until the client code finishes extracting
+//! all the results from the futures in [first, last) or until the continuations
+//! attached to the resulting future, using then(), finish processing.
+//!
+//! \sa then(), WaitableTimedOutException
+//!
+//! \return A std::future<std::tuple> with the input ForwardIterators, where all the
+//! futures in range [first, last) are ready.
+template<class TForwardIterator>
+all_accepts_fwd_iterator_t<TForwardIterator> all(std::shared_ptr<Executor> executor,
+                                                 std::chrono::nanoseconds timeLimit,
+                                                 TForwardIterator first,
+                                                 TForwardIterator last)
+{
+    return all<TForwardIterator>(std::move(executor),
+                                 Priority::Normal,
+                                 std::move(timeLimit),
+                                 first,
+                                 last);
+}
+
 //! \brief Creates a future that becomes ready when all the input futures become ready.
 //!
 //! \par The resulting future becomes ready when all the futures in range
@@ -478,7 +941,7 @@ all_accepts_fwd_iterator_t<TForwardIterator> all(std::shared_ptr<Executor> execu
 //! \return A std::future<std::tuple> with the input ForwardIterators, where all the
 //! futures in range [first, last) are ready.
 template<class TForwardIterator>
-all_accepts_fwd_iterator_t<TForwardIterator> all(std::chrono::microseconds timeLimit,
+all_accepts_fwd_iterator_t<TForwardIterator> all(std::chrono::nanoseconds timeLimit,
                                                  TForwardIterator first,
                                                  TForwardIterator last)
 {
@@ -521,5 +984,209 @@ all_accepts_fwd_iterator_t<TForwardIterator> all(TForwardIterator first,
                                  last);
 }
 
+//! \brief SFINAE meta-type that resolves to the future of the values contained by
+//! the futures of the given container.
+template<class TContainer>
+using all_values_t =
+    typename std::enable_if<
+        !detail::is_template<typename std::decay<TContainer>::type>::value ||
+        !std::is_same<
+            std::future<
+                typename detail::nth_template_param<0, typename std::decay<TContainer>::type>::type
+            >,
+            typename std::decay<TContainer>::type
+        >::value,
+        std::future<
+            std::vector<
+                typename detail::nth_template_param<
+                    0,
+                    typename std::decay<TContainer>::type::value_type
+                >::type
+            >
+        >
+    >::type;
+
+//! \brief Creates a future that becomes ready with the values of the input futures,
+//! or with the first exception among them.
+//!
+//! \par Unlike all(), the resulting future contains the values of the futures in the
+//! given container and becomes ready as soon as any of them is found to contain
+//! an exception, without waiting for the rest.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param futures The container that contains all the input futures, passed as
+//! an rvalue, since the futures are moved out of it.
+//!
+//! \note The values of the input futures have to be default-constructible, i.e.,
+//! containers of std::future<void> objects are not supported (see all()).
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa all(), WaitableTimedOutException
+//!
+//! \return An std::future<std::vector> that contains the values of the input futures,
+//! in the order of the container.
+template<class TContainer>
+all_values_t<TContainer> allValues(std::shared_ptr<Executor> executor,
+                                   std::chrono::nanoseconds timeLimit,
+                                   TContainer&& futures)
+{
+    static_assert(!std::is_lvalue_reference<TContainer>::value,
+                  "allValues() moves the futures out of the container, "
+                  "which has to be passed as an rvalue");
+
+    using T = typename detail::nth_template_param<
+            0,
+            typename std::decay<TContainer>::type::value_type
+        >::type;
+
+    std::vector<std::future<T>> inputs;
+    for (auto& f: futures) {
+        inputs.push_back(std::move(f));
+    }
+
+    std::promise<std::vector<T>> p;
+
+    auto result = p.get_future();
+
+    executor->watch(std::make_unique<detail::FutureWithValues<T>>(
+        std::move(timeLimit),
+        std::move(inputs),
+        std::move(p)
+    ));
+
+    return result;
+}
+
+//! \brief Creates a future that becomes ready with the values of the input futures,
+//! or with the first exception among them.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param futures The container that contains all the input futures.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds
+//! a maximum threshold defined by the library (typically 1h), the resulting future
+//! becomes ready with an exception of type WaitableTimedOutException.
+//!
+//! \sa all(), WaitableTimedOutException
+//!
+//! \return An std::future<std::vector> that contains the values of the input futures,
+//! in the order of the container.
+template<class TContainer>
+all_values_t<TContainer> allValues(std::shared_ptr<Executor> executor,
+                                   TContainer&& futures)
+{
+    return allValues(std::move(executor),
+                     std::chrono::hours(1),
+                     std::forward<TContainer>(futures));
+}
+
+//! \brief Creates a future that becomes ready with the values of the input futures,
+//! or with the first exception among them.
+//!
+//! \par This function uses the default Executor object to wait for the given
+//! futures to become ready.
+//!
+//! \param futures The container that contains all the input futures.
+//!
+//! \sa all(), Default, WaitableTimedOutException
+//!
+//! \return An std::future<std::vector> that contains the values of the input futures,
+//! in the order of the container.
+template<class TContainer>
+all_values_t<TContainer> allValues(TContainer&& futures)
+{
+    return allValues(Default<Executor>(),
+                     std::chrono::hours(1),
+                     std::forward<TContainer>(futures));
+}
+
+//! \brief Creates a future that becomes ready with the values of the input futures,
+//! or with the first exception among them.
+//!
+//! \par Unlike all(), the resulting future contains the values of the futures given
+//! as arguments and becomes ready as soon as any of them is found to contain an
+//! exception, without waiting for the rest.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param timeLimit The maximum time to wait for all the given futures to become ready.
+//! \param futures... The input futures as variable arguments.
+//!
+//! \note The values of the input futures have to be default-constructible.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa all(), WaitableTimedOutException
+//!
+//! \return An std::future<std::tuple> that contains the values of the input futures.
+template<typename Arg, typename... Args>
+std::future<std::tuple<Arg, Args...>> allValues(std::shared_ptr<Executor> executor,
+                                                std::chrono::nanoseconds timeLimit,
+                                                std::future<Arg> future,
+                                                std::future<Args>... futures)
+{
+    std::promise<std::tuple<Arg, Args...>> p;
+
+    auto result = p.get_future();
+
+    executor->watch(std::make_unique<detail::FutureWithValueTuple<Arg, Args...>>(
+        std::move(timeLimit),
+        std::tuple<std::future<Arg>, std::future<Args>...>{ std::move(future), std::move(futures)... },
+        std::move(p)
+    ));
+
+    return result;
+}
+
+//! \brief Creates a future that becomes ready with the values of the input futures,
+//! or with the first exception among them.
+//!
+//! \param executor The object that waits for the given futures to become ready.
+//! \param futures... The input futures as variable arguments.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds
+//! a maximum threshold defined by the library (typically 1h), the resulting future
+//! becomes ready with an exception of type WaitableTimedOutException.
+//!
+//! \sa all(), WaitableTimedOutException
+//!
+//! \return An std::future<std::tuple> that contains the values of the input futures.
+template<typename Arg, typename... Args>
+std::future<std::tuple<Arg, Args...>> allValues(std::shared_ptr<Executor> executor,
+                                                std::future<Arg> future,
+                                                std::future<Args>... futures)
+{
+    return allValues<Arg, Args...>(std::move(executor),
+                                   std::chrono::hours(1),
+                                   std::move(future),
+                                   std::move(futures)...);
+}
+
+//! \brief Creates a future that becomes ready with the values of the input futures,
+//! or with the first exception among them.
+//!
+//! \par This function uses the default Executor object to wait for the given
+//! futures to become ready.
+//!
+//! \param futures... The input futures as variable arguments.
+//!
+//! \sa all(), Default, WaitableTimedOutException
+//!
+//! \return An std::future<std::tuple> that contains the values of the input futures.
+template<typename Arg, typename... Args>
+std::future<std::tuple<Arg, Args...>> allValues(std::future<Arg> future,
+                                                std::future<Args>... futures)
+{
+    return allValues<Arg, Args...>(Default<Executor>(),
+                                   std::chrono::hours(1),
+                                   std::move(future),
+                                   std::move(futures)...);
+}
+
 } // namespace futures
 } // namespace thousandeyes
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <thousandeyes/futures/detail/Task.h>
+
+#include <thousandeyes/futures/CancellationToken.h>
+#include <thousandeyes/futures/Default.h>
+#include <thousandeyes/futures/Executor.h>
+#include <thousandeyes/futures/Future.h>
+
+namespace thousandeyes {
+namespace futures {
+
+//! \brief Meta-type that resolves to the type of the future returned by async().
+template<class TFunc>
+using async_result_t = Future<typename std::result_of<typename std::decay<TFunc>::type()>::type>;
+
+//! \brief Runs the given function on a thread owned by the executor.
+//!
+//! \par Unlike std::async(), no thread is created per call and the resulting
+//! #Future does not block when destroyed. Continuations attached to it with then()
+//! are invoked as soon as the function returns, without any polling.
+//!
+//! \param executor The object whose threads run the given function.
+//! \param token The token used to cancel the function before it starts.
+//! \param func The function to run.
+//!
+//! \note If the cancellation of the given token is requested before the function
+//! starts, the resulting future becomes ready with an exception of type
+//! WaitableCancelledException, without running the function.
+//!
+//! \sa Executor::post(), Future
+//!
+//! \return A #Future that contains the value returned by the given function.
+template<class TFunc>
+async_result_t<TFunc> async(std::shared_ptr<Executor> executor,
+                            CancellationToken token,
+                            TFunc&& func)
+{
+    using TOut = typename std::result_of<typename std::decay<TFunc>::type()>::type;
+
+    Promise<TOut> p;
+
+    auto result = p.get_future();
+
+    auto w = std::make_unique<detail::Task<TOut, typename std::decay<TFunc>::type>>(
+        std::move(p),
+        std::forward<TFunc>(func)
+    );
+
+    w->setCancellationToken(std::move(token));
+
+    executor->post(std::move(w));
+
+    return result;
+}
+
+//! \brief Runs the given function on a thread owned by the executor.
+//!
+//! \param executor The object whose threads run the given function.
+//! \param func The function to run.
+//!
+//! \sa Executor::post(), Future
+//!
+//! \return A #Future that contains the value returned by the given function.
+template<class TFunc>
+async_result_t<TFunc> async(std::shared_ptr<Executor> executor, TFunc&& func)
+{
+    return async(std::move(executor), CancellationToken(), std::forward<TFunc>(func));
+}
+
+//! \brief Runs the given function on a thread owned by the default executor.
+//!
+//! \param func The function to run.
+//!
+//! \sa Default, Executor::post(), Future
+//!
+//! \return A #Future that contains the value returned by the given function.
+template<class TFunc>
+async_result_t<TFunc> async(TFunc&& func)
+{
+    return async(Default<Executor>(), CancellationToken(), std::forward<TFunc>(func));
+}
+
+} // namespace futures
+} // namespace thousandeyes
@@ -22,14 +22,15 @@ namespace futures {
 namespace detail {
 
 template<class TIn, class TOut, class TFunc>
-class FutureWithChaining : public TimedWaitable {
+class FutureWithChaining final :
+    public StaticTimedWaitable<FutureWithChaining<TIn, TOut, TFunc>> {
 public:
-    FutureWithChaining(std::chrono::microseconds waitLimit,
+    FutureWithChaining(std::chrono::nanoseconds waitLimit,
                        std::weak_ptr<Executor> executor,
                        std::future<TIn> f,
                        std::promise<TOut> p,
                        TFunc&& cont) :
-        TimedWaitable(std::move(waitLimit)),
+        StaticTimedWaitable<FutureWithChaining>(std::move(waitLimit)),
         executor_(std::move(executor)),
         f_(std::move(f)),
         p_(std::move(p)),
@@ -42,7 +43,7 @@ public:
     FutureWithChaining(FutureWithChaining&& o) = default;
     FutureWithChaining& operator=(FutureWithChaining&& o) = default;
 
-    bool timedWait(const std::chrono::microseconds& timeout) override
+    bool timedWait(const std::chrono::microseconds& timeout)
     {
         return f_.wait_for(timeout) == std::future_status::ready;
     }
@@ -56,9 +57,13 @@ public:
 
         try {
             if (auto e = executor_.lock()) {
-                e->watch(std::make_unique<FutureWithForwarding<TOut>>(getTimeout(),
+                auto w = std::make_unique<FutureWithForwarding<TOut>>(this->getDeadline(),
                                                                       cont_(std::move(f_)),
-                                                                      std::move(p_)));
+                                                                      std::move(p_));
+                w->setPriority(this->priority());
+                w->setCancellationToken(this->cancellationToken());
+
+                e->watch(std::move(w));
             }
             else {
                 throw WaitableWaitException("No executor available");
@@ -20,12 +20,13 @@ namespace futures {
 namespace detail {
 
 template<class TContainer>
-class FutureWithContainer : public TimedWaitable {
+class FutureWithContainer final :
+    public StaticTimedWaitable<FutureWithContainer<TContainer>> {
 public:
-    FutureWithContainer(std::chrono::microseconds waitLimit,
+    FutureWithContainer(std::chrono::nanoseconds waitLimit,
                         TContainer&& futures,
                         std::promise<typename std::decay<TContainer>::type> p) :
-        TimedWaitable(std::move(waitLimit)),
+        StaticTimedWaitable<FutureWithContainer>(std::move(waitLimit)),
         futures_(std::forward<TContainer>(futures)),
         p_(std::move(p))
     {}
@@ -36,7 +37,7 @@ public:
     FutureWithContainer(FutureWithContainer&& o) = default;
     FutureWithContainer& operator=(FutureWithContainer&& o) = default;
 
-    bool timedWait(const std::chrono::microseconds& timeout) override
+    bool timedWait(const std::chrono::microseconds& timeout)
     {
         for (const auto& f: futures_) {
             if (f.wait_for(timeout) != std::future_status::ready) {
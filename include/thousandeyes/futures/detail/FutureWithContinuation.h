@@ -20,13 +20,14 @@ namespace futures {
 namespace detail {
 
 template<class TIn, class TOut, class TFunc>
-class FutureWithContinuation : public TimedWaitable {
+class FutureWithContinuation final :
+    public StaticTimedWaitable<FutureWithContinuation<TIn, TOut, TFunc>> {
 public:
-    FutureWithContinuation(std::chrono::microseconds waitLimit,
+    FutureWithContinuation(std::chrono::nanoseconds waitLimit,
                            std::future<TIn> f,
                            std::promise<TOut> p,
                            TFunc&& cont) :
-        TimedWaitable(std::move(waitLimit)),
+        StaticTimedWaitable<FutureWithContinuation>(std::move(waitLimit)),
         f_(std::move(f)),
         p_(std::move(p)),
         cont_(std::forward<TFunc>(cont))
@@ -38,7 +39,7 @@ public:
     FutureWithContinuation(FutureWithContinuation&& o) = default;
     FutureWithContinuation& operator=(FutureWithContinuation&& o) = default;
 
-    bool timedWait(const std::chrono::microseconds& timeout) override
+    bool timedWait(const std::chrono::microseconds& timeout)
     {
         return f_.wait_for(timeout) == std::future_status::ready;
     }
@@ -67,13 +68,14 @@ private:
 // Partial specialization for void output type
 
 template<class TIn, class TFunc>
-class FutureWithContinuation<TIn, void, TFunc> : public TimedWaitable {
+class FutureWithContinuation<TIn, void, TFunc> final :
+    public StaticTimedWaitable<FutureWithContinuation<TIn, void, TFunc>> {
 public:
-    FutureWithContinuation(std::chrono::microseconds waitLimit,
+    FutureWithContinuation(std::chrono::nanoseconds waitLimit,
                            std::future<TIn> f,
                            std::promise<void> p,
                            TFunc&& cont) :
-        TimedWaitable(std::move(waitLimit)),
+        StaticTimedWaitable<FutureWithContinuation>(std::move(waitLimit)),
         f_(std::move(f)),
         p_(std::move(p)),
         cont_(std::forward<TFunc>(cont))
@@ -85,7 +87,7 @@ public:
     FutureWithContinuation(FutureWithContinuation&& o) = default;
     FutureWithContinuation& operator=(FutureWithContinuation&& o) = default;
 
-    bool timedWait(const std::chrono::microseconds& timeout) override
+    bool timedWait(const std::chrono::microseconds& timeout)
     {
         return f_.wait_for(timeout) == std::future_status::ready;
     }
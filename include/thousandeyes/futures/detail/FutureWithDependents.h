@@ -0,0 +1,283 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <thousandeyes/futures/Executor.h>
+#include <thousandeyes/futures/TimedWaitable.h>
+#include <thousandeyes/futures/detail/FutureWithForwarding.h>
+#include <thousandeyes/futures/detail/typetraits.h>
+
+namespace thousandeyes {
+namespace futures {
+namespace detail {
+
+template<class T>
+struct unwrap_future {
+    using type = std::future<T>;
+};
+
+template<class T>
+struct unwrap_future<std::future<T>> {
+    using type = std::future<T>;
+};
+
+// The future returned for a continuation on std::shared_future<TIn>; continuations
+// that return an std::future are unwrapped, like the ones on std::future<TIn>
+template<class TIn, class TFunc>
+using shared_cont_future_t = typename unwrap_future<
+        typename std::result_of<
+            typename std::decay<TFunc>::type(std::shared_future<TIn>)
+        >::type
+    >::type;
+
+template<class T>
+struct is_future : std::false_type
+{};
+
+template<class T>
+struct is_future<std::future<T>> : std::true_type
+{};
+
+template<class TIn>
+class FutureWithDependents;
+
+template<class TIn>
+class Dependent {
+public:
+    virtual ~Dependent() = default;
+
+    // The waitable w provides the deadline, priority and cancellation token that
+    // are passed on to the futures returned by the continuations
+    virtual void dispatch(const std::shared_future<TIn>& f,
+                          const FutureWithDependents<TIn>& w,
+                          std::exception_ptr err) = 0;
+};
+
+template<class TIn, class TOut, class TFunc>
+class DependentWithContinuation : public Dependent<TIn> {
+public:
+    DependentWithContinuation(std::promise<TOut> p, TFunc cont) :
+        p_(std::move(p)),
+        cont_(std::move(cont))
+    {}
+
+    void dispatch(const std::shared_future<TIn>& f,
+                  const FutureWithDependents<TIn>& /* w */,
+                  std::exception_ptr err) override
+    {
+        if (err) {
+            p_.set_exception(err);
+            return;
+        }
+
+        try {
+            p_.set_value(cont_(f));
+        }
+        catch (...) {
+            p_.set_exception(std::current_exception());
+        }
+    }
+
+private:
+    std::promise<TOut> p_;
+    TFunc cont_;
+};
+
+// Partial specialization for void output type
+
+template<class TIn, class TFunc>
+class DependentWithContinuation<TIn, void, TFunc> : public Dependent<TIn> {
+public:
+    DependentWithContinuation(std::promise<void> p, TFunc cont) :
+        p_(std::move(p)),
+        cont_(std::move(cont))
+    {}
+
+    void dispatch(const std::shared_future<TIn>& f,
+                  const FutureWithDependents<TIn>& /* w */,
+                  std::exception_ptr err) override
+    {
+        if (err) {
+            p_.set_exception(err);
+            return;
+        }
+
+        try {
+            cont_(f);
+            p_.set_value();
+        }
+        catch (...) {
+            p_.set_exception(std::current_exception());
+        }
+    }
+
+private:
+    std::promise<void> p_;
+    TFunc cont_;
+};
+
+template<class TIn, class TOut, class TFunc>
+class DependentWithChaining : public Dependent<TIn> {
+public:
+    DependentWithChaining(std::weak_ptr<Executor> executor, std::promise<TOut> p, TFunc cont) :
+        executor_(std::move(executor)),
+        p_(std::move(p)),
+        cont_(std::move(cont))
+    {}
+
+    void dispatch(const std::shared_future<TIn>& f,
+                  const FutureWithDependents<TIn>& w,
+                  std::exception_ptr err) override
+    {
+        if (err) {
+            p_.set_exception(err);
+            return;
+        }
+
+        try {
+            if (auto e = executor_.lock()) {
+                auto fw = std::make_unique<FutureWithForwarding<TOut>>(w.getDeadline(),
+                                                                       cont_(f),
+                                                                       std::move(p_));
+                fw->setPriority(w.priority());
+                fw->setCancellationToken(w.cancellationToken());
+
+                e->watch(std::move(fw));
+            }
+            else {
+                throw WaitableWaitException("No executor available");
+            }
+        }
+        catch (...) {
+            p_.set_exception(std::current_exception());
+        }
+    }
+
+private:
+    std::weak_ptr<Executor> executor_;
+    std::promise<TOut> p_;
+    TFunc cont_;
+};
+
+template<class TIn>
+class FutureWithDependents final : public StaticTimedWaitable<FutureWithDependents<TIn>> {
+public:
+    FutureWithDependents(std::chrono::nanoseconds waitLimit,
+                         std::shared_future<TIn> f,
+                         std::vector<std::unique_ptr<Dependent<TIn>>> dependents) :
+        StaticTimedWaitable<FutureWithDependents>(std::move(waitLimit)),
+        f_(std::move(f)),
+        dependents_(std::move(dependents))
+    {}
+
+    FutureWithDependents(const FutureWithDependents& o) = delete;
+    FutureWithDependents& operator=(const FutureWithDependents& o) = delete;
+
+    FutureWithDependents(FutureWithDependents&& o) = default;
+    FutureWithDependents& operator=(FutureWithDependents&& o) = default;
+
+    using StaticTimedWaitable<FutureWithDependents<TIn>>::getDeadline;
+
+    bool timedWait(const std::chrono::microseconds& timeout)
+    {
+        return f_.wait_for(timeout) == std::future_status::ready;
+    }
+
+    void dispatch(std::exception_ptr err) override
+    {
+        for (auto& d: dependents_) {
+            d->dispatch(f_, *this, err);
+        }
+    }
+
+private:
+    std::shared_future<TIn> f_;
+    std::vector<std::unique_ptr<Dependent<TIn>>> dependents_;
+};
+
+template<class TIn, class TFunc>
+shared_cont_future_t<TIn, TFunc> addDependent(
+    std::vector<std::unique_ptr<Dependent<TIn>>>& dependents,
+    const std::weak_ptr<Executor>& /* executor */,
+    TFunc&& cont,
+    std::false_type /* returns future */)
+{
+    using TOut = typename std::result_of<
+            typename std::decay<TFunc>::type(std::shared_future<TIn>)
+        >::type;
+
+    std::promise<TOut> p;
+
+    auto result = p.get_future();
+
+    dependents.push_back(
+        std::make_unique<DependentWithContinuation<TIn, TOut, typename std::decay<TFunc>::type>>(
+            std::move(p),
+            std::forward<TFunc>(cont)
+        )
+    );
+
+    return result;
+}
+
+template<class TIn, class TFunc>
+shared_cont_future_t<TIn, TFunc> addDependent(
+    std::vector<std::unique_ptr<Dependent<TIn>>>& dependents,
+    const std::weak_ptr<Executor>& executor,
+    TFunc&& cont,
+    std::true_type /* returns future */)
+{
+    using TOut = typename nth_template_param<
+            0,
+            typename std::result_of<
+                typename std::decay<TFunc>::type(std::shared_future<TIn>)
+            >::type
+        >::type;
+
+    std::promise<TOut> p;
+
+    auto result = p.get_future();
+
+    dependents.push_back(
+        std::make_unique<DependentWithChaining<TIn, TOut, typename std::decay<TFunc>::type>>(
+            executor,
+            std::move(p),
+            std::forward<TFunc>(cont)
+        )
+    );
+
+    return result;
+}
+
+template<class TIn, class TFunc>
+shared_cont_future_t<TIn, TFunc> addDependent(
+    std::vector<std::unique_ptr<Dependent<TIn>>>& dependents,
+    const std::weak_ptr<Executor>& executor,
+    TFunc&& cont)
+{
+    using TResult = typename std::result_of<
+            typename std::decay<TFunc>::type(std::shared_future<TIn>)
+        >::type;
+
+    return addDependent<TIn>(dependents,
+                             executor,
+                             std::forward<TFunc>(cont),
+                             is_future<TResult>());
+}
+
+} // namespace detail
+} // namespace futures
+} // namespace thousandeyes
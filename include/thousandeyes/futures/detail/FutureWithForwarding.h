@@ -20,12 +20,32 @@ namespace futures {
 namespace detail {
 
 template<class T>
-class FutureWithForwarding : public TimedWaitable {
+void forwardValue(std::future<T>& f, std::promise<T>& p)
+{
+    p.set_value(f.get());
+}
+
+inline void forwardValue(std::future<void>& f, std::promise<void>& p)
+{
+    f.get();
+    p.set_value();
+}
+
+template<class T>
+class FutureWithForwarding final : public StaticTimedWaitable<FutureWithForwarding<T>> {
 public:
-    FutureWithForwarding(std::chrono::microseconds waitLimit,
+    FutureWithForwarding(std::chrono::nanoseconds waitLimit,
                          std::future<T> f,
                          std::promise<T> p) :
-        TimedWaitable(std::move(waitLimit)),
+        StaticTimedWaitable<FutureWithForwarding>(std::move(waitLimit)),
+        f_(std::move(f)),
+        p_(std::move(p))
+    {}
+
+    FutureWithForwarding(std::chrono::steady_clock::time_point deadline,
+                         std::future<T> f,
+                         std::promise<T> p) :
+        StaticTimedWaitable<FutureWithForwarding>(std::move(deadline)),
         f_(std::move(f)),
         p_(std::move(p))
     {}
@@ -36,7 +56,7 @@ public:
     FutureWithForwarding(FutureWithForwarding&& o) = default;
     FutureWithForwarding& operator=(FutureWithForwarding&& o) = default;
 
-    bool timedWait(const std::chrono::microseconds& timeout) override
+    bool timedWait(const std::chrono::microseconds& timeout)
     {
         return f_.wait_for(timeout) == std::future_status::ready;
     }
@@ -64,12 +84,21 @@ private:
 // Partial specialization for void output type
 
 template<>
-class FutureWithForwarding<void> : public TimedWaitable {
+class FutureWithForwarding<void> final :
+    public StaticTimedWaitable<FutureWithForwarding<void>> {
 public:
-    FutureWithForwarding(std::chrono::microseconds waitLimit,
+    FutureWithForwarding(std::chrono::nanoseconds waitLimit,
+                         std::future<void> f,
+                         std::promise<void> p) :
+        StaticTimedWaitable<FutureWithForwarding>(std::move(waitLimit)),
+        f_(std::move(f)),
+        p_(std::move(p))
+    {}
+
+    FutureWithForwarding(std::chrono::steady_clock::time_point deadline,
                          std::future<void> f,
                          std::promise<void> p) :
-        TimedWaitable(std::move(waitLimit)),
+        StaticTimedWaitable<FutureWithForwarding>(std::move(deadline)),
         f_(std::move(f)),
         p_(std::move(p))
     {}
@@ -80,7 +109,7 @@ public:
     FutureWithForwarding(FutureWithForwarding&& o) = default;
     FutureWithForwarding& operator=(FutureWithForwarding&& o) = default;
 
-    bool timedWait(const std::chrono::microseconds& timeout) override
+    bool timedWait(const std::chrono::microseconds& timeout)
     {
         return f_.wait_for(timeout) == std::future_status::ready;
     }
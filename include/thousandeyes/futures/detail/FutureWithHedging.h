@@ -0,0 +1,162 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <thousandeyes/futures/Executor.h>
+#include <thousandeyes/futures/TimedWaitable.h>
+#include <thousandeyes/futures/detail/FutureWithForwarding.h>
+
+namespace thousandeyes {
+namespace futures {
+namespace detail {
+
+template<class T, class TFactory>
+class FutureWithHedging final :
+    public StaticTimedWaitable<FutureWithHedging<T, TFactory>> {
+public:
+    FutureWithHedging(std::chrono::nanoseconds waitLimit,
+                      std::chrono::nanoseconds delay,
+                      std::size_t maxAttempts,
+                      std::weak_ptr<Executor> executor,
+                      std::promise<T> p,
+                      TFactory factory) :
+        StaticTimedWaitable<FutureWithHedging>(std::move(waitLimit)),
+        delay_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay)),
+        maxAttempts_(maxAttempts),
+        executor_(std::move(executor)),
+        p_(std::move(p)),
+        factory_(std::move(factory))
+    {
+        launch_(std::chrono::steady_clock::now());
+    }
+
+    FutureWithHedging(const FutureWithHedging& o) = delete;
+    FutureWithHedging& operator=(const FutureWithHedging& o) = delete;
+
+    FutureWithHedging(FutureWithHedging&& o) = default;
+    FutureWithHedging& operator=(FutureWithHedging&& o) = default;
+
+    bool timedWait(const std::chrono::microseconds& timeout)
+    {
+        for (auto& f: attempts_) {
+            if (f.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                return true;
+            }
+        }
+
+        if (launched_ >= maxAttempts_) {
+            return attempts_.front().wait_for(timeout) == std::future_status::ready;
+        }
+
+        // Waiting on the oldest attempt until the next one is due
+        auto remaining = next_ - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::steady_clock::duration(0)) {
+            return true;
+        }
+
+        auto q = std::min<std::chrono::nanoseconds>(timeout, remaining);
+        if (attempts_.front().wait_for(q) == std::future_status::ready) {
+            return true;
+        }
+
+        return std::chrono::steady_clock::now() >= next_;
+    }
+
+    void dispatch(std::exception_ptr err) override
+    {
+        if (err) {
+            p_.set_exception(err);
+            return;
+        }
+
+        for (auto& f: attempts_) {
+            if (f.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                continue;
+            }
+
+            try {
+                // The first successful attempt wins and the rest are abandoned
+                forwardValue(f, p_);
+                return;
+            }
+            catch (...) {
+                error_ = std::current_exception();
+            }
+        }
+
+        attempts_.erase(std::remove_if(attempts_.begin(), attempts_.end(), [](const auto& f) {
+            return !f.valid();
+        }), attempts_.end());
+
+        auto now = std::chrono::steady_clock::now();
+
+        // Failed attempts are replaced right away, instead of after the delay
+        if (launched_ < maxAttempts_ && (attempts_.empty() || now >= next_)) {
+            launch_(now);
+        }
+
+        if (attempts_.empty()) {
+            p_.set_exception(error_);
+            return;
+        }
+
+        watch_();
+    }
+
+private:
+    inline void launch_(std::chrono::steady_clock::time_point now)
+    {
+        ++launched_;
+        next_ = now + delay_;
+
+        try {
+            attempts_.push_back(factory_());
+        }
+        catch (...) {
+            std::promise<T> failed;
+            failed.set_exception(std::current_exception());
+            attempts_.push_back(failed.get_future());
+        }
+    }
+
+    inline void watch_()
+    {
+        auto e = executor_.lock();
+        if (!e) {
+            p_.set_exception(std::make_exception_ptr(WaitableWaitException("No executor available")));
+            return;
+        }
+
+        e->watch(std::make_unique<FutureWithHedging>(std::move(*this)));
+    }
+
+    std::chrono::steady_clock::duration delay_;
+    std::size_t maxAttempts_;
+    std::weak_ptr<Executor> executor_;
+    std::vector<std::future<T>> attempts_;
+    std::promise<T> p_;
+    TFactory factory_;
+    std::size_t launched_{ 0 };
+    std::chrono::steady_clock::time_point next_;
+    std::exception_ptr error_;
+};
+
+} // namespace detail
+} // namespace futures
+} // namespace thousandeyes
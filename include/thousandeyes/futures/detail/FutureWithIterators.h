@@ -20,13 +20,14 @@ namespace futures {
 namespace detail {
 
 template<class TForwardIterator>
-class FutureWithIterators : public TimedWaitable {
+class FutureWithIterators final :
+    public StaticTimedWaitable<FutureWithIterators<TForwardIterator>> {
 public:
-    FutureWithIterators(std::chrono::microseconds waitLimit,
+    FutureWithIterators(std::chrono::nanoseconds waitLimit,
                         TForwardIterator firstIter,
                         TForwardIterator lastIter,
                         std::promise<std::tuple<TForwardIterator, TForwardIterator>> p) :
-        TimedWaitable(std::move(waitLimit)),
+        StaticTimedWaitable<FutureWithIterators>(std::move(waitLimit)),
         range_(firstIter, lastIter),
         p_(std::move(p))
     {}
@@ -37,7 +38,7 @@ public:
     FutureWithIterators(FutureWithIterators&& o) = default;
     FutureWithIterators& operator=(FutureWithIterators&& o) = default;
 
-    bool timedWait(const std::chrono::microseconds& timeout) override
+    bool timedWait(const std::chrono::microseconds& timeout)
     {
         TForwardIterator end = std::get<1>(range_);
         for (TForwardIterator iter = std::get<0>(range_); iter != end; ++iter) {
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <thousandeyes/futures/Executor.h>
+#include <thousandeyes/futures/TimedWaitable.h>
+
+namespace thousandeyes {
+namespace futures {
+namespace detail {
+
+template<class TContainer, class TOut, class TFunc>
+class FutureWithMapping final :
+    public StaticTimedWaitable<FutureWithMapping<TContainer, TOut, TFunc>> {
+public:
+    FutureWithMapping(std::chrono::nanoseconds waitLimit,
+                      std::size_t maxInFlight,
+                      std::weak_ptr<Executor> executor,
+                      TContainer input,
+                      std::promise<std::vector<std::future<TOut>>> p,
+                      TFunc func) :
+        StaticTimedWaitable<FutureWithMapping>(std::move(waitLimit)),
+        maxInFlight_(maxInFlight),
+        executor_(std::move(executor)),
+        state_(std::make_unique<State>(std::move(input))),
+        p_(std::move(p)),
+        func_(std::move(func))
+    {
+        launch_();
+    }
+
+    FutureWithMapping(const FutureWithMapping& o) = delete;
+    FutureWithMapping& operator=(const FutureWithMapping& o) = delete;
+
+    FutureWithMapping(FutureWithMapping&& o) = default;
+    FutureWithMapping& operator=(FutureWithMapping&& o) = default;
+
+    bool timedWait(const std::chrono::microseconds& timeout)
+    {
+        auto& inFlight = state_->inFlight;
+
+        if (inFlight.empty()) {
+            return true;
+        }
+
+        for (std::size_t i: inFlight) {
+            if (isReady_(i, std::chrono::seconds(0))) {
+                return true;
+            }
+        }
+
+        return isReady_(inFlight.front(), timeout);
+    }
+
+    void dispatch(std::exception_ptr err) override
+    {
+        if (err) {
+            p_.set_exception(err);
+            return;
+        }
+
+        auto& inFlight = state_->inFlight;
+
+        inFlight.erase(std::remove_if(inFlight.begin(), inFlight.end(), [this](std::size_t i) {
+            return isReady_(i, std::chrono::seconds(0));
+        }), inFlight.end());
+
+        launch_();
+
+        if (!inFlight.empty()) {
+            watch_();
+            return;
+        }
+
+        try {
+            p_.set_value(std::move(state_->results));
+        }
+        catch (...) {
+            p_.set_exception(std::current_exception());
+        }
+    }
+
+private:
+    // Kept behind a pointer, so that the input iterator survives moving the
+    // object when it is watched again
+    struct State {
+        explicit State(TContainer input) :
+            input(std::move(input)),
+            next(std::begin(this->input))
+        {
+            results.reserve(static_cast<std::size_t>(
+                std::distance(std::begin(this->input), std::end(this->input))));
+        }
+
+        TContainer input;
+        decltype(std::begin(input)) next;
+        std::vector<std::future<TOut>> results;
+        std::vector<std::size_t> inFlight;
+    };
+
+    inline bool isReady_(std::size_t i, const std::chrono::microseconds& timeout) const
+    {
+        return state_->results[i].wait_for(timeout) == std::future_status::ready;
+    }
+
+    inline void launch_()
+    {
+        auto& s = *state_;
+
+        while (s.inFlight.size() < maxInFlight_ && s.next != std::end(s.input)) {
+            try {
+                s.results.push_back(func_(std::move(*s.next)));
+            }
+            catch (...) {
+                std::promise<TOut> failed;
+                failed.set_exception(std::current_exception());
+                s.results.push_back(failed.get_future());
+            }
+
+            ++s.next;
+            s.inFlight.push_back(s.results.size() - 1);
+        }
+    }
+
+    inline void watch_()
+    {
+        auto e = executor_.lock();
+        if (!e) {
+            p_.set_exception(std::make_exception_ptr(WaitableWaitException("No executor available")));
+            return;
+        }
+
+        e->watch(std::make_unique<FutureWithMapping>(std::move(*this)));
+    }
+
+    std::size_t maxInFlight_;
+    std::weak_ptr<Executor> executor_;
+    std::unique_ptr<State> state_;
+    std::promise<std::vector<std::future<TOut>>> p_;
+    TFunc func_;
+};
+
+} // namespace detail
+} // namespace futures
+} // namespace thousandeyes
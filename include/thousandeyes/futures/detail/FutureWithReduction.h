@@ -0,0 +1,142 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <thousandeyes/futures/Executor.h>
+#include <thousandeyes/futures/TimedWaitable.h>
+
+namespace thousandeyes {
+namespace futures {
+namespace detail {
+
+template<class TIn, class TAcc, class TFunc>
+class FutureWithReduction final :
+    public StaticTimedWaitable<FutureWithReduction<TIn, TAcc, TFunc>> {
+public:
+    FutureWithReduction(std::chrono::nanoseconds waitLimit,
+                        bool isOrdered,
+                        std::weak_ptr<Executor> executor,
+                        std::vector<std::future<TIn>> futures,
+                        TAcc init,
+                        std::promise<TAcc> p,
+                        TFunc op) :
+        StaticTimedWaitable<FutureWithReduction>(std::move(waitLimit)),
+        isOrdered_(isOrdered),
+        executor_(std::move(executor)),
+        futures_(std::move(futures)),
+        acc_(std::move(init)),
+        p_(std::move(p)),
+        op_(std::move(op))
+    {}
+
+    FutureWithReduction(const FutureWithReduction& o) = delete;
+    FutureWithReduction& operator=(const FutureWithReduction& o) = delete;
+
+    FutureWithReduction(FutureWithReduction&& o) = default;
+    FutureWithReduction& operator=(FutureWithReduction&& o) = default;
+
+    bool timedWait(const std::chrono::microseconds& timeout)
+    {
+        if (next_ == futures_.size()) {
+            return true;
+        }
+
+        if (!isOrdered_) {
+            for (std::size_t i = next_; i < futures_.size(); ++i) {
+                if (isReady_(i, std::chrono::seconds(0))) {
+                    return true;
+                }
+            }
+        }
+
+        return isReady_(next_, timeout);
+    }
+
+    void dispatch(std::exception_ptr err) override
+    {
+        if (err) {
+            p_.set_exception(err);
+            return;
+        }
+
+        try {
+            if (isOrdered_) {
+                while (next_ < futures_.size() && isReady_(next_, std::chrono::seconds(0))) {
+                    fold_(next_++);
+                }
+            }
+            else {
+                // The ready futures are folded and moved before next_, so that
+                // only the pending ones are polled again
+                for (std::size_t i = next_; i < futures_.size(); ++i) {
+                    if (isReady_(i, std::chrono::seconds(0))) {
+                        fold_(i);
+                        std::swap(futures_[i], futures_[next_++]);
+                    }
+                }
+            }
+        }
+        catch (...) {
+            p_.set_exception(std::current_exception());
+            return;
+        }
+
+        if (next_ < futures_.size()) {
+            watch_();
+            return;
+        }
+
+        p_.set_value(std::move(acc_));
+    }
+
+private:
+    inline bool isReady_(std::size_t i, const std::chrono::microseconds& timeout) const
+    {
+        return futures_[i].wait_for(timeout) == std::future_status::ready;
+    }
+
+    inline void fold_(std::size_t i)
+    {
+        acc_ = op_(std::move(acc_), futures_[i].get());
+
+        // Releases the shared state of the folded future
+        futures_[i] = std::future<TIn>();
+    }
+
+    inline void watch_()
+    {
+        auto e = executor_.lock();
+        if (!e) {
+            p_.set_exception(std::make_exception_ptr(WaitableWaitException("No executor available")));
+            return;
+        }
+
+        e->watch(std::make_unique<FutureWithReduction>(std::move(*this)));
+    }
+
+    bool isOrdered_;
+    std::weak_ptr<Executor> executor_;
+    std::vector<std::future<TIn>> futures_;
+    std::size_t next_{ 0 };
+    TAcc acc_;
+    std::promise<TAcc> p_;
+    TFunc op_;
+};
+
+} // namespace detail
+} // namespace futures
+} // namespace thousandeyes
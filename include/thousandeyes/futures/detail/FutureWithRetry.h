@@ -0,0 +1,167 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <thread>
+
+#include <thousandeyes/futures/Executor.h>
+#include <thousandeyes/futures/RetryPolicy.h>
+#include <thousandeyes/futures/TimedWaitable.h>
+#include <thousandeyes/futures/detail/FutureWithForwarding.h>
+
+namespace thousandeyes {
+namespace futures {
+namespace detail {
+
+template<class T, class TFactory>
+class FutureWithRetry final : public StaticTimedWaitable<FutureWithRetry<T, TFactory>> {
+public:
+    FutureWithRetry(RetryPolicy policy,
+                    std::weak_ptr<Executor> executor,
+                    std::promise<T> p,
+                    TFactory factory) :
+        StaticTimedWaitable<FutureWithRetry>(policy.timeLimit),
+        policy_(std::move(policy)),
+        executor_(std::move(executor)),
+        p_(std::move(p)),
+        factory_(std::move(factory))
+    {
+        start_();
+    }
+
+    FutureWithRetry(const FutureWithRetry& o) = delete;
+    FutureWithRetry& operator=(const FutureWithRetry& o) = delete;
+
+    FutureWithRetry(FutureWithRetry&& o) = default;
+    FutureWithRetry& operator=(FutureWithRetry&& o) = default;
+
+    bool timedWait(const std::chrono::microseconds& timeout)
+    {
+        if (f_.valid()) {
+            return f_.wait_for(timeout) == std::future_status::ready;
+        }
+
+        // Backing off until the next attempt
+        auto remaining = backoff_ - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::steady_clock::duration(0)) {
+            return true;
+        }
+
+        std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(timeout, remaining));
+
+        return std::chrono::steady_clock::now() >= backoff_;
+    }
+
+    void dispatch(std::exception_ptr err) override
+    {
+        if (err) {
+            p_.set_exception(err);
+            return;
+        }
+
+        if (!f_.valid()) {
+            // The backoff has passed; the next attempt is subject to the same
+            // limits as the one that scheduled it
+            if (attempts_ >= policy_.maxAttempts ||
+                std::chrono::steady_clock::now() >= this->getDeadline()) {
+                p_.set_exception(error_);
+                return;
+            }
+
+            start_();
+            watch_();
+            return;
+        }
+
+        try {
+            forwardValue(f_, p_);
+            return;
+        }
+        catch (...) {
+            err = std::current_exception();
+        }
+
+        if (attempts_ >= policy_.maxAttempts) {
+            p_.set_exception(err);
+            return;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        auto delay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            policy_.delay(attempts_));
+
+        if (now + delay >= this->getDeadline()) {
+            p_.set_exception(err);
+            return;
+        }
+
+        error_ = err;
+        backoff_ = now + delay;
+        watch_();
+    }
+
+private:
+    inline void start_()
+    {
+        ++attempts_;
+
+        std::exception_ptr err;
+
+        try {
+            f_ = factory_();
+        }
+        catch (...) {
+            err = std::current_exception();
+        }
+
+        // An invalid future is a failed attempt, so that it is not mistaken for
+        // the backoff by timedWait()
+        if (!err && !f_.valid()) {
+            err = std::make_exception_ptr(std::future_error(std::future_errc::no_state));
+        }
+
+        if (err) {
+            std::promise<T> failed;
+            failed.set_exception(err);
+            f_ = failed.get_future();
+        }
+    }
+
+    inline void watch_()
+    {
+        auto e = executor_.lock();
+        if (!e) {
+            p_.set_exception(std::make_exception_ptr(WaitableWaitException("No executor available")));
+            return;
+        }
+
+        // The same attempt counter, promise and deadline move on to the next poll
+        e->watch(std::make_unique<FutureWithRetry>(std::move(*this)));
+    }
+
+    RetryPolicy policy_;
+    std::weak_ptr<Executor> executor_;
+    std::future<T> f_;
+    std::promise<T> p_;
+    TFactory factory_;
+    std::size_t attempts_{ 0 };
+    std::chrono::steady_clock::time_point backoff_;
+    std::exception_ptr error_;
+};
+
+} // namespace detail
+} // namespace futures
+} // namespace thousandeyes
@@ -40,12 +40,12 @@ struct TupleItemsWaitFor<0, T> {
 };
 
 template<typename... Args>
-class FutureWithTuple : public TimedWaitable {
+class FutureWithTuple final : public StaticTimedWaitable<FutureWithTuple<Args...>> {
 public:
-    FutureWithTuple(std::chrono::microseconds waitLimit,
+    FutureWithTuple(std::chrono::nanoseconds waitLimit,
                     std::tuple<std::future<Args>...> futures,
                     std::promise<std::tuple<std::future<Args>...>> p) :
-        TimedWaitable(std::move(waitLimit)),
+        StaticTimedWaitable<FutureWithTuple>(std::move(waitLimit)),
         futures_(std::move(futures)),
         p_(std::move(p))
     {}
@@ -56,7 +56,7 @@ public:
     FutureWithTuple(FutureWithTuple&& o) = default;
     FutureWithTuple& operator=(FutureWithTuple&& o) = default;
 
-    bool timedWait(const std::chrono::microseconds& timeout) override
+    bool timedWait(const std::chrono::microseconds& timeout)
     {
         return TupleItemsWaitFor<sizeof...(Args) - 1,
                                  std::tuple<std::future<Args>...>>()(futures_, timeout);
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <future>
+#include <initializer_list>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <thousandeyes/futures/TimedWaitable.h>
+
+namespace thousandeyes {
+namespace futures {
+namespace detail {
+
+template<class T>
+class FutureWithValues final : public StaticTimedWaitable<FutureWithValues<T>> {
+public:
+    FutureWithValues(std::chrono::nanoseconds waitLimit,
+                     std::vector<std::future<T>> futures,
+                     std::promise<std::vector<T>> p) :
+        StaticTimedWaitable<FutureWithValues>(std::move(waitLimit)),
+        futures_(std::move(futures)),
+        values_(futures_.size()),
+        p_(std::move(p))
+    {
+        for (std::size_t i = 0; i < futures_.size(); ++i) {
+            pending_.push_back(i);
+        }
+    }
+
+    FutureWithValues(const FutureWithValues& o) = delete;
+    FutureWithValues& operator=(const FutureWithValues& o) = delete;
+
+    FutureWithValues(FutureWithValues&& o) = default;
+    FutureWithValues& operator=(FutureWithValues&& o) = default;
+
+    bool timedWait(const std::chrono::microseconds& timeout)
+    {
+        if (collect_()) {
+            return true;
+        }
+
+        futures_[pending_.front()].wait_for(timeout);
+
+        return collect_();
+    }
+
+    void dispatch(std::exception_ptr err) override
+    {
+        if (err || (err = error_)) {
+            p_.set_exception(err);
+            return;
+        }
+
+        p_.set_value(std::move(values_));
+    }
+
+private:
+    // Retrieves the values of the ready futures, stopping at the first exception,
+    // and returns whether the object is ready
+    inline bool collect_()
+    {
+        auto ready = [this](std::size_t i) {
+            if (error_ || futures_[i].wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return false;
+            }
+
+            try {
+                values_[i] = futures_[i].get();
+            }
+            catch (...) {
+                error_ = std::current_exception();
+            }
+
+            return true;
+        };
+
+        pending_.erase(std::remove_if(pending_.begin(), pending_.end(), ready), pending_.end());
+
+        return error_ || pending_.empty();
+    }
+
+    std::vector<std::future<T>> futures_;
+    std::vector<T> values_;
+    std::vector<std::size_t> pending_;
+    std::exception_ptr error_;
+    std::promise<std::vector<T>> p_;
+};
+
+template<typename... Args>
+class FutureWithValueTuple final :
+    public StaticTimedWaitable<FutureWithValueTuple<Args...>> {
+public:
+    FutureWithValueTuple(std::chrono::nanoseconds waitLimit,
+                         std::tuple<std::future<Args>...> futures,
+                         std::promise<std::tuple<Args...>> p) :
+        StaticTimedWaitable<FutureWithValueTuple>(std::move(waitLimit)),
+        futures_(std::move(futures)),
+        p_(std::move(p))
+    {}
+
+    FutureWithValueTuple(const FutureWithValueTuple& o) = delete;
+    FutureWithValueTuple& operator=(const FutureWithValueTuple& o) = delete;
+
+    FutureWithValueTuple(FutureWithValueTuple&& o) = default;
+    FutureWithValueTuple& operator=(FutureWithValueTuple&& o) = default;
+
+    bool timedWait(const std::chrono::microseconds& timeout)
+    {
+        if (collect_(std::index_sequence_for<Args...>())) {
+            return true;
+        }
+
+        auto pending = std::find(ready_.begin(), ready_.end(), false) - ready_.begin();
+        waitFor_(static_cast<std::size_t>(pending), timeout, std::index_sequence_for<Args...>());
+
+        return collect_(std::index_sequence_for<Args...>());
+    }
+
+    void dispatch(std::exception_ptr err) override
+    {
+        if (err || (err = error_)) {
+            p_.set_exception(err);
+            return;
+        }
+
+        p_.set_value(std::move(values_));
+    }
+
+private:
+    template<std::size_t N>
+    inline void collect_()
+    {
+        if (error_ || ready_[N] ||
+            std::get<N>(futures_).wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;
+        }
+
+        try {
+            std::get<N>(values_) = std::get<N>(futures_).get();
+        }
+        catch (...) {
+            error_ = std::current_exception();
+        }
+
+        ready_[N] = true;
+    }
+
+    // Retrieves the values of the ready futures, stopping at the first exception,
+    // and returns whether the object is ready
+    template<std::size_t... N>
+    inline bool collect_(std::index_sequence<N...>)
+    {
+        (void) std::initializer_list<int>{ (collect_<N>(), 0)... };
+
+        return error_ || std::all_of(ready_.begin(), ready_.end(), [](bool r) { return r; });
+    }
+
+    template<std::size_t... N>
+    inline void waitFor_(std::size_t i,
+                         const std::chrono::microseconds& timeout,
+                         std::index_sequence<N...>)
+    {
+        (void) std::initializer_list<int>{
+            (N == i ? (std::get<N>(futures_).wait_for(timeout), 0) : 0)...
+        };
+    }
+
+    std::tuple<std::future<Args>...> futures_;
+    std::tuple<Args...> values_;
+    std::array<bool, sizeof...(Args)> ready_{};
+    std::exception_ptr error_;
+    std::promise<std::tuple<Args...>> p_;
+};
+
+} // namespace detail
+} // namespace futures
+} // namespace thousandeyes
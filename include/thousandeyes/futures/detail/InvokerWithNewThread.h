@@ -14,6 +14,7 @@
 #include <mutex>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace thousandeyes {
 namespace futures {
@@ -26,9 +27,18 @@ public:
         std::lock_guard<std::mutex> lock(m_);
 
         for (auto& t: ts_) {
-            if (t.joinable() && t.get_id() != std::this_thread::get_id()) {
+            if (!t.joinable()) {
+                continue;
+            }
+
+            // The last reference to the owning executor may be released from
+            // within one of the invoked functions
+            if (t.get_id() != std::this_thread::get_id()) {
                 t.join();
             }
+            else {
+                t.detach();
+            }
         }
     }
 
@@ -12,6 +12,7 @@
 
 #include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -23,27 +24,33 @@ namespace detail {
 
 class InvokerWithSingleThread {
 public:
-    InvokerWithSingleThread()
+    InvokerWithSingleThread() :
+        state_(std::make_shared<State>())
     {
-        t_ = std::thread([this]() {
+        // The thread shares ownership of the state, since it can outlive
+        // the invoker when the invoker is destroyed by one of the invoked functions
+        t_ = std::thread([state=state_]() {
             while (true) {
-                std::function<void()> f;
+                std::queue<std::function<void()>> fs;
                 {
-                    std::unique_lock<std::mutex> lock(m_);
+                    std::unique_lock<std::mutex> lock(state->m);
 
-                    while (fs_.empty() && active_) {
-                        cv_.wait(lock);
+                    while (state->fs.empty() && state->active) {
+                        state->cv.wait(lock);
                     }
 
-                    if (!active_) {
+                    if (!state->active) {
                         break;
                     }
 
-                    f = std::move(fs_.front());
-                    fs_.pop();
+                    // Drain all the pending functions at once
+                    fs.swap(state->fs);
                 }
 
-                f();
+                while (!fs.empty()) {
+                    fs.front()();
+                    fs.pop();
+                }
             }
         });
     }
@@ -52,42 +59,53 @@ public:
     {
         bool wasActive;
         {
-            std::lock_guard<std::mutex> lock(m_);
+            std::lock_guard<std::mutex> lock(state_->m);
 
-            wasActive = active_;
-            active_ = false;
+            wasActive = state_->active;
+            state_->active = false;
         }
 
         if (wasActive) {
-            cv_.notify_one();
+            state_->cv.notify_one();
+        }
+
+        if (!t_.joinable()) {
+            return;
         }
 
-        if (t_.joinable() && t_.get_id() != std::this_thread::get_id()) {
+        if (t_.get_id() != std::this_thread::get_id()) {
             t_.join();
         }
+        else {
+            t_.detach();
+        }
     }
 
     void operator()(std::function<void()> f)
     {
         bool wasEmpty;
         {
-            std::lock_guard<std::mutex> lock(m_);
+            std::lock_guard<std::mutex> lock(state_->m);
 
-            wasEmpty = fs_.empty();
-            fs_.push(std::move(f));
+            wasEmpty = state_->fs.empty();
+            state_->fs.push(std::move(f));
         }
 
         if (wasEmpty) {
-            cv_.notify_one();
+            state_->cv.notify_one();
         }
     }
 
 private:
-    std::mutex m_;
-    std::condition_variable cv_;
+    struct State {
+        std::mutex m;
+        std::condition_variable cv;
+        bool active{ true };
+        std::queue<std::function<void()>> fs;
+    };
+
+    std::shared_ptr<State> state_;
     std::thread t_;
-    bool active_{ true };
-    std::queue<std::function<void()>> fs_;
 };
 
 } // namespace detail
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace thousandeyes {
+namespace futures {
+namespace detail {
+
+// Runs the given functions on a pool of threads that grows with the load up to
+// maxThreads. When the invoker is destroyed, the functions that are queued but
+// not started yet still run, before the threads are joined, so that the work
+// they own (e.g., the promise of an async() call) is never silently dropped.
+class InvokerWithThreadPool {
+public:
+    InvokerWithThreadPool() :
+        InvokerWithThreadPool(std::max(1u, std::thread::hardware_concurrency()))
+    {}
+
+    explicit InvokerWithThreadPool(std::size_t maxThreads) :
+        maxThreads_(std::max<std::size_t>(1, maxThreads)),
+        state_(std::make_shared<State>())
+    {}
+
+    ~InvokerWithThreadPool()
+    {
+        std::vector<std::thread> ts;
+        {
+            std::lock_guard<std::mutex> lock(state_->m);
+
+            state_->active = false;
+            ts.swap(ts_);
+        }
+
+        state_->cv.notify_all();
+
+        for (std::thread& t: ts) {
+            if (t.get_id() != std::this_thread::get_id()) {
+                t.join();
+            }
+            else {
+                t.detach();
+            }
+        }
+    }
+
+    void operator()(std::function<void()> f)
+    {
+        {
+            std::lock_guard<std::mutex> lock(state_->m);
+
+            state_->fs.push(std::move(f));
+
+            // Threads are only started when there are no idle ones left, so
+            // that the pool grows up to maxThreads_ with the load
+            if (state_->fs.size() > state_->idle && ts_.size() < maxThreads_) {
+                ts_.emplace_back(&InvokerWithThreadPool::run_, state_);
+                return;
+            }
+        }
+
+        state_->cv.notify_one();
+    }
+
+private:
+    struct State {
+        std::mutex m;
+        std::condition_variable cv;
+        bool active{ true };
+        std::size_t idle{ 0 };
+        std::queue<std::function<void()>> fs;
+    };
+
+    // The threads share ownership of the state, since they can outlive
+    // the invoker when the invoker is destroyed by one of the invoked functions
+    static void run_(std::shared_ptr<State> state)
+    {
+        while (true) {
+            std::function<void()> f;
+            {
+                std::unique_lock<std::mutex> lock(state->m);
+
+                ++state->idle;
+                state->cv.wait(lock, [&state]() {
+                    return !state->fs.empty() || !state->active;
+                });
+                --state->idle;
+
+                // The queued functions are drained before the threads exit
+                if (state->fs.empty()) {
+                    break;
+                }
+
+                f = std::move(state->fs.front());
+                state->fs.pop();
+            }
+
+            f();
+        }
+    }
+
+    const std::size_t maxThreads_;
+    std::shared_ptr<State> state_;
+    std::vector<std::thread> ts_;
+};
+
+} // namespace detail
+} // namespace futures
+} // namespace thousandeyes
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace thousandeyes {
+namespace futures {
+namespace detail {
+
+//! \brief Invoker that runs the given functions directly on the calling thread
+//! (e.g., the polling thread) for as long as they are cheap.
+//!
+//! \note The invoker keeps a moving average of the time it takes to run the given
+//! functions. While the average exceeds the time budget, the functions are handed
+//! to the TFallback invoker instead.
+//!
+//! \note The average starts at twice the budget, so the first functions are handed
+//! to the TFallback invoker until they are measured to be cheap. A function that
+//! overruns the budget raises the average to, at least, its own run time, so that
+//! the following ones are handed off right away.
+//!
+//! \note A function that runs a batch of count continuations, such as the ones
+//! dispatched by the #PollingExecutor, is given as operator()(f, count). The budget
+//! then applies to each continuation, i.e., the run time of the batch is divided
+//! by count before it is averaged, so that a burst of cheap continuations that
+//! become ready together keeps running inline.
+template<class TFallback>
+class InvokerWithTimeBudget {
+public:
+    InvokerWithTimeBudget() :
+        InvokerWithTimeBudget(std::chrono::microseconds(100))
+    {}
+
+    explicit InvokerWithTimeBudget(std::chrono::microseconds budget) :
+        budget_(std::chrono::duration_cast<std::chrono::nanoseconds>(budget).count()),
+        stats_(std::make_shared<Stats>(2 * budget_)),
+        fallback_(std::make_unique<TFallback>())
+    {}
+
+    InvokerWithTimeBudget(std::chrono::microseconds budget, TFallback&& fallback) :
+        budget_(std::chrono::duration_cast<std::chrono::nanoseconds>(budget).count()),
+        stats_(std::make_shared<Stats>(2 * budget_)),
+        fallback_(std::make_unique<TFallback>(std::forward<TFallback>(fallback)))
+    {}
+
+    void operator()(std::function<void()> f)
+    {
+        (*this)(std::move(f), 1);
+    }
+
+    void operator()(std::function<void()> f, std::size_t count)
+    {
+        if (stats_->average.load(std::memory_order_relaxed) <= budget_) {
+            run_(*stats_, budget_, f, count);
+            return;
+        }
+
+        (*fallback_)([stats=stats_, budget=budget_, f=std::move(f), count]() {
+            run_(*stats, budget, f, count);
+        });
+    }
+
+private:
+    struct Stats {
+        explicit Stats(std::int64_t initial) :
+            average(initial)
+        {}
+
+        std::atomic<std::int64_t> average;
+    };
+
+    static void run_(Stats& stats,
+                     std::int64_t budget,
+                     const std::function<void()>& f,
+                     std::size_t count)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        f();
+
+        // The run time of each of the count continuations run by f
+        std::int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start
+        ).count() / static_cast<std::int64_t>(std::max<std::size_t>(count, 1));
+
+        // Exponentially weighted moving average with a weight of 1/8 for the
+        // latest sample; concurrent updates may lose samples, which is fine
+        std::int64_t average = stats.average.load(std::memory_order_relaxed);
+        average += (elapsed - average) / 8;
+
+        // A single overrun is enough to stop running functions inline
+        if (elapsed > budget && elapsed > average) {
+            average = elapsed;
+        }
+
+        stats.average.store(average, std::memory_order_relaxed);
+    }
+
+    const std::int64_t budget_;
+    std::shared_ptr<Stats> stats_;
+    std::unique_ptr<TFallback> fallback_;
+};
+
+} // namespace detail
+} // namespace futures
+} // namespace thousandeyes
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace thousandeyes {
+namespace futures {
+namespace detail {
+
+class Callback {
+public:
+    virtual ~Callback() = default;
+
+    virtual void invoke() = 0;
+};
+
+// The state shared by a Promise and its Future. The result is stored once and,
+// at most, one callback is attached; the two are synchronized with a single
+// atomic status, so that whichever comes second invokes the callback. Any number
+// of threads can block in wait() and wait_for(); they are counted, so that
+// storing the result only locks a mutex when some thread is blocked.
+class SharedStateBase {
+public:
+    SharedStateBase() = default;
+
+    SharedStateBase(const SharedStateBase& o) = delete;
+    SharedStateBase& operator=(const SharedStateBase& o) = delete;
+
+    virtual ~SharedStateBase() = default;
+
+    inline bool isReady() const
+    {
+        return status_.load(std::memory_order_acquire) == Ready;
+    }
+
+    inline bool isSatisfied() const
+    {
+        return satisfied_.load(std::memory_order_relaxed);
+    }
+
+    inline void setException(std::exception_ptr err)
+    {
+        satisfy_();
+        error_ = std::move(err);
+        complete_();
+    }
+
+    // Invokes the callback when the result is stored, or right away if it
+    // already is
+    inline void attach(Callback* callback)
+    {
+        callback_ = callback;
+
+        int expected = Pending;
+        if (!status_.compare_exchange_strong(expected, Attached, std::memory_order_acq_rel)) {
+            callback->invoke();
+        }
+    }
+
+    inline void wait() const
+    {
+        if (isReady()) {
+            return;
+        }
+
+        auto& slot = waitSlot_(this);
+
+        std::unique_lock<std::mutex> lock(slot.mutex);
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        slot.cond.wait(lock, [this]() { return isCompleted_(); });
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    template<class TRep, class TPeriod>
+    std::future_status wait_for(const std::chrono::duration<TRep, TPeriod>& timeout) const
+    {
+        if (isReady()) {
+            return std::future_status::ready;
+        }
+
+        auto& slot = waitSlot_(this);
+
+        std::unique_lock<std::mutex> lock(slot.mutex);
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        bool isDone = slot.cond.wait_for(lock, timeout, [this]() { return isCompleted_(); });
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+
+        return isDone ? std::future_status::ready : std::future_status::timeout;
+    }
+
+protected:
+    inline void satisfy_()
+    {
+        if (satisfied_.exchange(true, std::memory_order_relaxed)) {
+            throw std::future_error(std::future_errc::promise_already_satisfied);
+        }
+    }
+
+    inline void unsatisfy_()
+    {
+        satisfied_.store(false, std::memory_order_relaxed);
+    }
+
+    inline void complete_()
+    {
+        auto status = status_.exchange(Ready, std::memory_order_seq_cst);
+
+        // Either the blocked thread is counted here, or it finds the state ready
+        if (waiters_.load(std::memory_order_seq_cst) > 0) {
+            auto& slot = waitSlot_(this);
+
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            slot.cond.notify_all();
+        }
+
+        if (status == Attached) {
+            callback_->invoke();
+        }
+    }
+
+    inline void rethrow_() const
+    {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    enum Status {
+        Pending = 0,
+        Attached = 1,
+        Ready = 2
+    };
+
+    // The blocked threads share a few mutexes and condition variables, picked by
+    // the address of the state, so that each state does not carry its own
+    struct WaitSlot {
+        std::mutex mutex;
+        std::condition_variable cond;
+    };
+
+    static inline WaitSlot& waitSlot_(const SharedStateBase* state)
+    {
+        static WaitSlot slots[16];
+        return slots[(reinterpret_cast<std::uintptr_t>(state) / alignof(SharedStateBase)) % 16];
+    }
+
+    inline bool isCompleted_() const
+    {
+        return status_.load(std::memory_order_seq_cst) == Ready;
+    }
+
+    std::atomic<int> status_{ Pending };
+    std::atomic<bool> satisfied_{ false };
+    mutable std::atomic<int> waiters_{ 0 };
+    Callback* callback_{ nullptr };
+    std::exception_ptr error_;
+};
+
+template<class T>
+class SharedState : public SharedStateBase {
+public:
+    ~SharedState()
+    {
+        if (hasValue_) {
+            reinterpret_cast<T*>(&storage_)->~T();
+        }
+    }
+
+    template<class... Args>
+    void setValue(Args&&... args)
+    {
+        satisfy_();
+
+        try {
+            new (&storage_) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            unsatisfy_();
+            throw;
+        }
+
+        hasValue_ = true;
+        complete_();
+    }
+
+    // Requires the result to be stored
+    inline T get()
+    {
+        rethrow_();
+        return std::move(*reinterpret_cast<T*>(&storage_));
+    }
+
+private:
+    // The value is stored inline, in the same allocation as the state
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_;
+    bool hasValue_{ false };
+};
+
+template<>
+class SharedState<void> : public SharedStateBase {
+public:
+    inline void setValue()
+    {
+        satisfy_();
+        complete_();
+    }
+
+    // Requires the result to be stored
+    inline void get()
+    {
+        rethrow_();
+    }
+};
+
+} // namespace detail
+} // namespace futures
+} // namespace thousandeyes
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <chrono>
+#include <exception>
+#include <utility>
+
+#include <thousandeyes/futures/Future.h>
+#include <thousandeyes/futures/Waitable.h>
+
+namespace thousandeyes {
+namespace futures {
+namespace detail {
+
+template<class T, class TFunc>
+void invokeInto(Promise<T>& p, TFunc& func)
+{
+    p.set_value(func());
+}
+
+template<class TFunc>
+void invokeInto(Promise<void>& p, TFunc& func)
+{
+    func();
+    p.set_value();
+}
+
+// A Waitable that is always ready and runs its function when dispatched
+template<class T, class TFunc>
+class Task : public Waitable {
+public:
+    Task(Promise<T> p, TFunc func) :
+        p_(std::move(p)),
+        func_(std::move(func))
+    {}
+
+    Task(const Task& o) = delete;
+    Task& operator=(const Task& o) = delete;
+
+    Task(Task&& o) = default;
+    Task& operator=(Task&& o) = default;
+
+    bool wait(const std::chrono::microseconds& /* q */) override
+    {
+        return true;
+    }
+
+    void dispatch(std::exception_ptr err) override
+    {
+        if (err) {
+            p_.set_exception(err);
+            return;
+        }
+
+        try {
+            invokeInto(p_, func_);
+        }
+        catch (...) {
+            p_.set_exception(std::current_exception());
+        }
+    }
+
+private:
+    Promise<T> p_;
+    TFunc func_;
+};
+
+} // namespace detail
+} // namespace futures
+} // namespace thousandeyes
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include <thousandeyes/futures/Waitable.h>
+
+namespace thousandeyes {
+namespace futures {
+namespace detail {
+
+class Timer : public Waitable {
+public:
+    Timer(std::chrono::steady_clock::time_point deadline,
+          std::promise<void> p) :
+        Waitable(toTimestamp(deadline)),
+        p_(std::move(p))
+    {}
+
+    Timer(const Timer& o) = delete;
+    Timer& operator=(const Timer& o) = delete;
+
+    Timer(Timer&& o) = default;
+    Timer& operator=(Timer&& o) = default;
+
+    bool wait(const std::chrono::microseconds& q) override
+    {
+        return wait(q, toTimestamp(std::chrono::steady_clock::now()));
+    }
+
+    bool wait(const std::chrono::microseconds& q,
+              const std::chrono::nanoseconds& timestamp) override
+    {
+        if (expired(timestamp)) {
+            return true;
+        }
+
+        // Sleeping until the deadline, if it is within q, behaves like
+        // waiting on a future that becomes ready at the deadline
+        std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(q, timeout(timestamp)));
+
+        return expired(toTimestamp(std::chrono::steady_clock::now()));
+    }
+
+    void dispatch(std::exception_ptr err) override
+    {
+        if (err) {
+            p_.set_exception(err);
+            return;
+        }
+
+        p_.set_value();
+    }
+
+private:
+    std::promise<void> p_;
+};
+
+} // namespace detail
+} // namespace futures
+} // namespace thousandeyes
@@ -0,0 +1,185 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <thousandeyes/futures/Waitable.h>
+#include <thousandeyes/futures/detail/deadlines.h>
+
+namespace thousandeyes {
+namespace futures {
+namespace detail {
+
+// A FIFO queue of waitables, stored as a ring buffer of parallel arrays, so that
+// the deadlines of the queued waitables can be scanned contiguously,
+// without dereferencing the waitables themselves. The deadlines of the unused
+// slots are 0, i.e., unset, so that the whole array can be scanned at once
+class WaitableQueue {
+public:
+    struct Entry {
+        std::unique_ptr<Waitable> w;
+        std::chrono::nanoseconds deadline;
+    };
+
+    WaitableQueue() = default;
+
+    WaitableQueue(const WaitableQueue& o) = delete;
+    WaitableQueue& operator=(const WaitableQueue& o) = delete;
+
+    WaitableQueue(WaitableQueue&& o) = default;
+    WaitableQueue& operator=(WaitableQueue&& o) = default;
+
+    inline bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    inline std::size_t size() const
+    {
+        return size_;
+    }
+
+    inline void push(std::unique_ptr<Waitable> w)
+    {
+        auto deadline = w->deadline();
+
+        push(Entry{ std::move(w), deadline });
+    }
+
+    inline void push(Entry e)
+    {
+        if (size_ == waitables_.size()) {
+            resize_(waitables_.empty() ? minCapacity_ : 2 * waitables_.size());
+        }
+
+        std::size_t i = index_(size_);
+
+        waitables_[i] = std::move(e.w);
+        deadlines_[i] = e.deadline.count();
+
+        ++size_;
+    }
+
+    // Requires the queue not to be empty
+    inline Entry pop()
+    {
+        Entry e{
+            std::move(waitables_[head_]),
+            std::chrono::nanoseconds(deadlines_[head_])
+        };
+
+        deadlines_[head_] = 0;
+
+        head_ = index_(1);
+        --size_;
+
+        // Releases the memory of a queue that shrank considerably
+        if (waitables_.size() > minCapacity_ && size_ <= waitables_.size() / 8) {
+            resize_(waitables_.size() / 2);
+        }
+
+        return e;
+    }
+
+    // Moves the waitables whose deadline is set and not after the given timestamp
+    // to the given vector, keeping their order, and returns their number
+    std::size_t takeExpired(std::chrono::nanoseconds timestamp, std::vector<Entry>& expired)
+    {
+        if (size_ == 0) {
+            return 0;
+        }
+
+        mask_.assign(maskWords(deadlines_.size()), 0);
+
+        std::size_t found = findExpired(deadlines_.data(),
+                                        deadlines_.size(),
+                                        timestamp.count(),
+                                        mask_.data());
+        if (found == 0) {
+            return 0;
+        }
+
+        // Compacts the remaining waitables towards the head
+        std::size_t kept = 0;
+        for (std::size_t n = 0; n < size_; ++n) {
+            std::size_t i = index_(n);
+
+            if ((mask_[i / 64] >> (i % 64)) & 1) {
+                expired.push_back(Entry{
+                    std::move(waitables_[i]),
+                    std::chrono::nanoseconds(deadlines_[i])
+                });
+                continue;
+            }
+
+            if (kept != n) {
+                std::size_t j = index_(kept);
+
+                waitables_[j] = std::move(waitables_[i]);
+                deadlines_[j] = deadlines_[i];
+            }
+
+            ++kept;
+        }
+
+        for (std::size_t n = kept; n < size_; ++n) {
+            std::size_t i = index_(n);
+
+            deadlines_[i] = 0;
+        }
+
+        size_ = kept;
+
+        return found;
+    }
+
+private:
+    static constexpr std::size_t minCapacity_ = 64;
+
+    // The capacity is always a power of 2
+    inline std::size_t index_(std::size_t offset) const
+    {
+        return (head_ + offset) & (waitables_.size() - 1);
+    }
+
+    void resize_(std::size_t capacity)
+    {
+        std::vector<std::unique_ptr<Waitable>> waitables(capacity);
+        std::vector<std::int64_t> deadlines(capacity);
+
+        for (std::size_t n = 0; n < size_; ++n) {
+            std::size_t i = index_(n);
+
+            waitables[n] = std::move(waitables_[i]);
+            deadlines[n] = deadlines_[i];
+        }
+
+        waitables_.swap(waitables);
+        deadlines_.swap(deadlines);
+        head_ = 0;
+    }
+
+    std::vector<std::unique_ptr<Waitable>> waitables_;
+    std::vector<std::int64_t> deadlines_;
+    std::vector<std::uint64_t> mask_;
+    std::size_t head_{ 0 };
+    std::size_t size_{ 0 };
+};
+
+} // namespace detail
+} // namespace futures
+} // namespace thousandeyes
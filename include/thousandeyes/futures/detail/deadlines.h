@@ -0,0 +1,137 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(THOUSANDEYES_FUTURES_NO_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#endif
+
+namespace thousandeyes {
+namespace futures {
+namespace detail {
+
+// The number of 64-bit words of the mask for the given number of deadlines
+inline std::size_t maskWords(std::size_t count)
+{
+    return (count + 63) / 64;
+}
+
+// Sets the bit i of the mask for each deadline i, starting from the given one,
+// that is set (i.e., positive) and not after the given timestamp, and returns
+// the number of bits set
+inline std::size_t findExpiredScalar(const std::int64_t* deadlines,
+                                     std::size_t count,
+                                     std::int64_t timestamp,
+                                     std::uint64_t* mask,
+                                     std::size_t first = 0)
+{
+    std::size_t found = 0;
+
+    for (std::size_t i = first; i < count; ++i) {
+        if (deadlines[i] > 0 && deadlines[i] <= timestamp) {
+            mask[i / 64] |= std::uint64_t(1) << (i % 64);
+            ++found;
+        }
+    }
+
+    return found;
+}
+
+#if !defined(THOUSANDEYES_FUTURES_NO_SIMD) && defined(__AVX2__)
+
+inline std::size_t findExpired(const std::int64_t* deadlines,
+                               std::size_t count,
+                               std::int64_t timestamp,
+                               std::uint64_t* mask)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i now = _mm256_set1_epi64x(timestamp);
+
+    std::size_t found = 0;
+    std::size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(deadlines + i));
+
+        // deadline > 0 && !(deadline > now)
+        __m256i m = _mm256_andnot_si256(_mm256_cmpgt_epi64(d, now),
+                                        _mm256_cmpgt_epi64(d, zero));
+
+        auto bits = static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+        if (bits != 0) {
+            mask[i / 64] |= bits << (i % 64);
+            found += (bits & 1) + ((bits >> 1) & 1) + ((bits >> 2) & 1) + (bits >> 3);
+        }
+    }
+
+    return found + findExpiredScalar(deadlines, count, timestamp, mask, i);
+}
+
+#elif !defined(THOUSANDEYES_FUTURES_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+
+// SSE2 lacks a 64-bit comparison: the high halves are compared as signed and,
+// when they are equal, the borrow of subtracting the low halves decides
+inline __m128i cmpgt64(__m128i a, __m128i b)
+{
+    __m128i r = _mm_and_si128(_mm_cmpeq_epi32(a, b), _mm_sub_epi64(b, a));
+    r = _mm_or_si128(r, _mm_cmpgt_epi32(a, b));
+    return _mm_shuffle_epi32(r, _MM_SHUFFLE(3, 3, 1, 1));
+}
+
+inline std::size_t findExpired(const std::int64_t* deadlines,
+                               std::size_t count,
+                               std::int64_t timestamp,
+                               std::uint64_t* mask)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i now = _mm_set1_epi64x(timestamp);
+
+    std::size_t found = 0;
+    std::size_t i = 0;
+
+    for (; i + 2 <= count; i += 2) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(deadlines + i));
+
+        // deadline > 0 && !(deadline > now)
+        __m128i m = _mm_andnot_si128(cmpgt64(d, now), cmpgt64(d, zero));
+
+        auto bits = static_cast<std::uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(m)));
+        if (bits != 0) {
+            mask[i / 64] |= bits << (i % 64);
+            found += (bits & 1) + (bits >> 1);
+        }
+    }
+
+    return found + findExpiredScalar(deadlines, count, timestamp, mask, i);
+}
+
+#else
+
+inline std::size_t findExpired(const std::int64_t* deadlines,
+                               std::size_t count,
+                               std::int64_t timestamp,
+                               std::uint64_t* mask)
+{
+    return findExpiredScalar(deadlines, count, timestamp, mask);
+}
+
+#endif
+
+} // namespace detail
+} // namespace futures
+} // namespace thousandeyes
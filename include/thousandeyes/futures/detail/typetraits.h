@@ -10,7 +10,11 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <functional>
 #include <type_traits>
+#include <utility>
 
 namespace thousandeyes {
 namespace futures {
@@ -60,6 +64,35 @@ struct nth_template_param<0, C<T, P...>>
     using type = T;
 };
 
+// has_phased_drain
+
+template <class T, class = void>
+struct has_phased_drain : std::false_type
+{};
+
+template <class T>
+struct has_phased_drain<T, decltype(
+    std::declval<T&>().beginDrain(),
+    std::declval<T&>().waitDrained(std::declval<std::chrono::steady_clock::time_point>()),
+    std::declval<T&>().setOwner(std::declval<const void*>()),
+    std::declval<const T&>().watchCount(),
+    void()
+)> : std::true_type
+{};
+
+// has_counted_call
+
+template <class T, class = void>
+struct has_counted_call : std::false_type
+{};
+
+template <class T>
+struct has_counted_call<T, decltype(
+    std::declval<T&>()(std::declval<std::function<void()>>(), std::declval<std::size_t>()),
+    void()
+)> : std::true_type
+{};
+
 } // namespace detail
 } // namespace futures
 } // namespace thousandeyes
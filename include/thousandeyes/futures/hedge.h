@@ -0,0 +1,151 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+#include <thousandeyes/futures/detail/FutureWithHedging.h>
+#include <thousandeyes/futures/detail/typetraits.h>
+
+#include <thousandeyes/futures/CancellationToken.h>
+#include <thousandeyes/futures/Default.h>
+#include <thousandeyes/futures/Executor.h>
+
+namespace thousandeyes {
+namespace futures {
+
+//! \brief Meta-type that resolves to the value type of the futures returned
+//! by the given factory.
+template<class TFactory>
+using hedge_value_t =
+    typename detail::nth_template_param<
+        0,
+        typename std::result_of<typename std::decay<TFactory>::type()>::type
+    >::type;
+
+//! \brief Creates a future that becomes ready with the first successful
+//! attempt made by the given factory.
+//!
+//! \par The factory is invoked once immediately and, as long as no attempt has
+//! succeeded, once more every time the given delay passes (e.g., the p95 latency
+//! of the operation), up to maxAttempts times. An attempt that fails is replaced
+//! immediately. The executor watches all the outstanding attempts, and the delays
+//! between them, with a single #Waitable object.
+//!
+//! \param executor The object that waits for the attempts.
+//! \param token The token used to cancel waiting for the attempts.
+//! \param timeLimit The maximum time to wait for an attempt to succeed.
+//! \param delay The time after which another attempt is started.
+//! \param maxAttempts The maximum number of attempts, including the first one.
+//! \param factory The function that starts an attempt, returning its std::future.
+//!
+//! \note Once an attempt succeeds, the futures of the other outstanding attempts
+//! are abandoned; they are not waited for.
+//!
+//! \note If all the attempts fail, the resulting future becomes ready with the
+//! exception of the last failed attempt.
+//!
+//! \note If no attempt succeeds within the given timeLimit, the resulting future
+//! becomes ready with an exception of type WaitableTimedOutException.
+//!
+//! \sa CancellationToken, WaitableTimedOutException, WaitableCancelledException
+//!
+//! \return An std::future<value> that contains the value of the first successful
+//! attempt.
+template<class TFactory>
+std::future<hedge_value_t<TFactory>> hedge(std::shared_ptr<Executor> executor,
+                                           CancellationToken token,
+                                           std::chrono::nanoseconds timeLimit,
+                                           std::chrono::nanoseconds delay,
+                                           std::size_t maxAttempts,
+                                           TFactory&& factory)
+{
+    using T = hedge_value_t<TFactory>;
+
+    std::promise<T> p;
+
+    auto result = p.get_future();
+
+    auto w = std::make_unique<detail::FutureWithHedging<T, typename std::decay<TFactory>::type>>(
+        std::move(timeLimit),
+        std::move(delay),
+        std::max<std::size_t>(maxAttempts, 1),
+        executor,
+        std::move(p),
+        std::forward<TFactory>(factory)
+    );
+
+    w->setCancellationToken(std::move(token));
+
+    executor->watch(std::move(w));
+
+    return result;
+}
+
+//! \brief Creates a future that becomes ready with the first successful
+//! attempt made by the given factory.
+//!
+//! \param executor The object that waits for the attempts.
+//! \param delay The time after which another attempt is started.
+//! \param maxAttempts The maximum number of attempts, including the first one.
+//! \param factory The function that starts an attempt, returning its std::future.
+//!
+//! \note If no attempt succeeds within a maximum threshold defined by the library
+//! (typically 1h), the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \return An std::future<value> that contains the value of the first successful
+//! attempt.
+template<class TFactory>
+std::future<hedge_value_t<TFactory>> hedge(std::shared_ptr<Executor> executor,
+                                           std::chrono::nanoseconds delay,
+                                           std::size_t maxAttempts,
+                                           TFactory&& factory)
+{
+    return hedge(std::move(executor),
+                 CancellationToken(),
+                 std::chrono::hours(1),
+                 std::move(delay),
+                 maxAttempts,
+                 std::forward<TFactory>(factory));
+}
+
+//! \brief Creates a future that becomes ready with the first successful
+//! attempt made by the given factory.
+//!
+//! \par This function uses the default Executor object to wait for the attempts.
+//!
+//! \param delay The time after which another attempt is started.
+//! \param maxAttempts The maximum number of attempts, including the first one.
+//! \param factory The function that starts an attempt, returning its std::future.
+//!
+//! \sa Default
+//!
+//! \return An std::future<value> that contains the value of the first successful
+//! attempt.
+template<class TFactory>
+std::future<hedge_value_t<TFactory>> hedge(std::chrono::nanoseconds delay,
+                                           std::size_t maxAttempts,
+                                           TFactory&& factory)
+{
+    return hedge(Default<Executor>(),
+                 std::move(delay),
+                 maxAttempts,
+                 std::forward<TFactory>(factory));
+}
+
+} // namespace futures
+} // namespace thousandeyes
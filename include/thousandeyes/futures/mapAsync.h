@@ -0,0 +1,158 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <thousandeyes/futures/detail/FutureWithMapping.h>
+#include <thousandeyes/futures/detail/typetraits.h>
+
+#include <thousandeyes/futures/Default.h>
+#include <thousandeyes/futures/Executor.h>
+
+namespace thousandeyes {
+namespace futures {
+
+//! \brief Meta-type that resolves to the value type of the futures returned
+//! by the given function for the elements of the given container.
+template<class TContainer, class TFunc>
+using map_value_t =
+    typename detail::nth_template_param<
+        0,
+        typename std::result_of<
+            typename std::decay<TFunc>::type(
+                typename std::decay<TContainer>::type::value_type&&
+            )
+        >::type
+    >::type;
+
+//! \brief Creates a future that becomes ready when the futures obtained by
+//! applying the given function to each element of the given container become ready.
+//!
+//! \par At most maxInFlight of the futures returned by the function are outstanding
+//! at any time; the function is applied to the next elements as the earlier futures
+//! become ready. The executor watches all the outstanding futures with a single
+//! #Waitable object, so that its queue does not grow with the size of the container.
+//!
+//! \note Only the number of outstanding operations is bounded, not the memory used:
+//! the future of each element is kept until all of them are ready, since the
+//! resulting future contains them all, so the memory used grows with the size of
+//! the container.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param timeLimit The maximum time to wait for all the futures to become ready.
+//! \param maxInFlight The maximum number of outstanding futures.
+//! \param input The container whose elements are passed to the function.
+//! \param func The function that returns a future for a given element.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa all(), WaitableTimedOutException
+//!
+//! \return An std::future<std::vector<std::future<value>>> that contains the futures
+//! returned by the function, in the order of the input elements, where all the
+//! contained futures are ready.
+template<class TContainer, class TFunc>
+std::future<std::vector<std::future<map_value_t<TContainer, TFunc>>>> mapAsync(
+    std::shared_ptr<Executor> executor,
+    std::chrono::nanoseconds timeLimit,
+    std::size_t maxInFlight,
+    TContainer&& input,
+    TFunc&& func)
+{
+    using TOut = map_value_t<TContainer, TFunc>;
+
+    std::promise<std::vector<std::future<TOut>>> p;
+
+    auto result = p.get_future();
+
+    auto w = std::make_unique<detail::FutureWithMapping<typename std::decay<TContainer>::type,
+                                                        TOut,
+                                                        typename std::decay<TFunc>::type>>(
+        std::move(timeLimit),
+        std::max<std::size_t>(maxInFlight, 1),
+        executor,
+        std::forward<TContainer>(input),
+        std::move(p),
+        std::forward<TFunc>(func)
+    );
+
+    executor->watch(std::move(w));
+
+    return result;
+}
+
+//! \brief Creates a future that becomes ready when the futures obtained by
+//! applying the given function to each element of the given container become ready.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param maxInFlight The maximum number of outstanding futures.
+//! \param input The container whose elements are passed to the function.
+//! \param func The function that returns a future for a given element.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds a maximum
+//! threshold defined by the library (typically 1h), the resulting future becomes
+//! ready with an exception of type WaitableTimedOutException.
+//!
+//! \return An std::future<std::vector<std::future<value>>> that contains the futures
+//! returned by the function, in the order of the input elements, where all the
+//! contained futures are ready.
+template<class TContainer, class TFunc>
+std::future<std::vector<std::future<map_value_t<TContainer, TFunc>>>> mapAsync(
+    std::shared_ptr<Executor> executor,
+    std::size_t maxInFlight,
+    TContainer&& input,
+    TFunc&& func)
+{
+    return mapAsync(std::move(executor),
+                    std::chrono::hours(1),
+                    maxInFlight,
+                    std::forward<TContainer>(input),
+                    std::forward<TFunc>(func));
+}
+
+//! \brief Creates a future that becomes ready when the futures obtained by
+//! applying the given function to each element of the given container become ready.
+//!
+//! \par This function uses the default Executor object to wait for the futures
+//! to become ready.
+//!
+//! \param maxInFlight The maximum number of outstanding futures.
+//! \param input The container whose elements are passed to the function.
+//! \param func The function that returns a future for a given element.
+//!
+//! \sa Default
+//!
+//! \return An std::future<std::vector<std::future<value>>> that contains the futures
+//! returned by the function, in the order of the input elements, where all the
+//! contained futures are ready.
+template<class TContainer, class TFunc>
+std::future<std::vector<std::future<map_value_t<TContainer, TFunc>>>> mapAsync(
+    std::size_t maxInFlight,
+    TContainer&& input,
+    TFunc&& func)
+{
+    return mapAsync(Default<Executor>(),
+                    maxInFlight,
+                    std::forward<TContainer>(input),
+                    std::forward<TFunc>(func));
+}
+
+} // namespace futures
+} // namespace thousandeyes
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <thousandeyes/futures/detail/FutureWithReduction.h>
+#include <thousandeyes/futures/detail/typetraits.h>
+
+#include <thousandeyes/futures/Default.h>
+#include <thousandeyes/futures/Executor.h>
+
+namespace thousandeyes {
+namespace futures {
+
+//! \brief The order in which reduce() folds the values of the input futures.
+enum class ReduceOrder {
+    //! \brief Each value is folded as soon as its future is found ready.
+    Completion,
+    //! \brief The values are folded in the order of the input futures, each
+    //! one as soon as it and all the preceding futures are ready.
+    Input
+};
+
+//! \brief Creates a future that becomes ready with the result of folding the
+//! values of the input futures with the given operation.
+//!
+//! \par Each value is folded into the accumulator, i.e., acc = op(acc, value), as
+//! soon as it can be, and the corresponding future is released, so that the values
+//! are not kept until all the input futures become ready. The resulting future
+//! becomes ready right after the last value is folded.
+//!
+//! \param executor The object that waits for the input futures to become ready.
+//! \param timeLimit The maximum time to wait for all the input futures to become ready.
+//! \param order The order in which the values are folded.
+//! \param futures The container that contains all the input futures.
+//! \param init The initial value of the accumulator.
+//! \param op The operation that folds a value into the accumulator.
+//!
+//! \note If an input future or the operation throws, the resulting future becomes
+//! ready with that exception right away, and the rest of the input futures are
+//! no longer waited for.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa ReduceOrder, all(), WaitableTimedOutException
+//!
+//! \return An std::future<TAcc> that contains the final value of the accumulator.
+template<class TContainer, class TAcc, class TFunc>
+std::future<typename std::decay<TAcc>::type> reduce(std::shared_ptr<Executor> executor,
+                                                    std::chrono::nanoseconds timeLimit,
+                                                    ReduceOrder order,
+                                                    TContainer&& futures,
+                                                    TAcc&& init,
+                                                    TFunc&& op)
+{
+    using TIn = typename detail::nth_template_param<
+            0,
+            typename std::decay<TContainer>::type::value_type
+        >::type;
+    using TOut = typename std::decay<TAcc>::type;
+
+    std::vector<std::future<TIn>> inputs;
+    for (auto& f: futures) {
+        inputs.push_back(std::move(f));
+    }
+
+    std::promise<TOut> p;
+
+    auto result = p.get_future();
+
+    auto w = std::make_unique<detail::FutureWithReduction<TIn, TOut, typename std::decay<TFunc>::type>>(
+        std::move(timeLimit),
+        order == ReduceOrder::Input,
+        executor,
+        std::move(inputs),
+        std::forward<TAcc>(init),
+        std::move(p),
+        std::forward<TFunc>(op)
+    );
+
+    executor->watch(std::move(w));
+
+    return result;
+}
+
+//! \brief Creates a future that becomes ready with the result of folding the
+//! values of the input futures with the given operation.
+//!
+//! \param executor The object that waits for the input futures to become ready.
+//! \param order The order in which the values are folded.
+//! \param futures The container that contains all the input futures.
+//! \param init The initial value of the accumulator.
+//! \param op The operation that folds a value into the accumulator.
+//!
+//! \note If the total time for waiting the input futures to become ready exceeds
+//! a maximum threshold defined by the library (typically 1h), the resulting future
+//! becomes ready with an exception of type WaitableTimedOutException.
+//!
+//! \sa ReduceOrder
+//!
+//! \return An std::future<TAcc> that contains the final value of the accumulator.
+template<class TContainer, class TAcc, class TFunc>
+std::future<typename std::decay<TAcc>::type> reduce(std::shared_ptr<Executor> executor,
+                                                    ReduceOrder order,
+                                                    TContainer&& futures,
+                                                    TAcc&& init,
+                                                    TFunc&& op)
+{
+    return reduce(std::move(executor),
+                  std::chrono::hours(1),
+                  order,
+                  std::forward<TContainer>(futures),
+                  std::forward<TAcc>(init),
+                  std::forward<TFunc>(op));
+}
+
+//! \brief Creates a future that becomes ready with the result of folding the
+//! values of the input futures, in the order they become ready, with the given
+//! operation.
+//!
+//! \param executor The object that waits for the input futures to become ready.
+//! \param futures The container that contains all the input futures.
+//! \param init The initial value of the accumulator.
+//! \param op The operation that folds a value into the accumulator.
+//!
+//! \sa ReduceOrder
+//!
+//! \return An std::future<TAcc> that contains the final value of the accumulator.
+template<class TContainer, class TAcc, class TFunc>
+std::future<typename std::decay<TAcc>::type> reduce(std::shared_ptr<Executor> executor,
+                                                    TContainer&& futures,
+                                                    TAcc&& init,
+                                                    TFunc&& op)
+{
+    return reduce(std::move(executor),
+                  ReduceOrder::Completion,
+                  std::forward<TContainer>(futures),
+                  std::forward<TAcc>(init),
+                  std::forward<TFunc>(op));
+}
+
+//! \brief Creates a future that becomes ready with the result of folding the
+//! values of the input futures, in the order they become ready, with the given
+//! operation.
+//!
+//! \par This function uses the default Executor object to wait for the input
+//! futures to become ready.
+//!
+//! \param futures The container that contains all the input futures.
+//! \param init The initial value of the accumulator.
+//! \param op The operation that folds a value into the accumulator.
+//!
+//! \sa ReduceOrder, Default
+//!
+//! \return An std::future<TAcc> that contains the final value of the accumulator.
+template<class TContainer, class TAcc, class TFunc>
+std::future<typename std::decay<TAcc>::type> reduce(TContainer&& futures,
+                                                    TAcc&& init,
+                                                    TFunc&& op)
+{
+    return reduce(Default<Executor>(),
+                  std::forward<TContainer>(futures),
+                  std::forward<TAcc>(init),
+                  std::forward<TFunc>(op));
+}
+
+} // namespace futures
+} // namespace thousandeyes
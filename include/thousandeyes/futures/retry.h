@@ -0,0 +1,138 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <future>
+#include <memory>
+#include <type_traits>
+
+#include <thousandeyes/futures/detail/FutureWithRetry.h>
+#include <thousandeyes/futures/detail/typetraits.h>
+
+#include <thousandeyes/futures/CancellationToken.h>
+#include <thousandeyes/futures/Default.h>
+#include <thousandeyes/futures/Executor.h>
+#include <thousandeyes/futures/RetryPolicy.h>
+
+namespace thousandeyes {
+namespace futures {
+
+//! \brief Meta-type that resolves to the value type of the futures returned
+//! by the given factory.
+template<class TFactory>
+using retry_value_t =
+    typename detail::nth_template_param<
+        0,
+        typename std::result_of<typename std::decay<TFactory>::type()>::type
+    >::type;
+
+//! \brief Creates a future that becomes ready when one of the attempts made
+//! by the given factory succeeds.
+//!
+//! \par The factory is invoked once immediately and, every time the future it
+//! returns becomes ready with an exception, once more after the delay given by
+//! the policy. The delays are waited by the executor, like the attempts, so no
+//! thread sleeps while backing off.
+//!
+//! \param executor The object that waits for the attempts and the delays between them.
+//! \param token The token used to cancel any remaining attempts.
+//! \param policy The policy that determines the number of attempts, the delays
+//! between them and their total time limit.
+//! \param factory The function that starts an attempt, returning its std::future.
+//!
+//! \note If all the attempts fail, the resulting future becomes ready with the
+//! exception of the last attempt. No attempt is started if its delay would exceed
+//! the policy's time limit.
+//!
+//! \note If an attempt is not ready within the policy's time limit, the resulting
+//! future becomes ready with an exception of type WaitableTimedOutException.
+//!
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa RetryPolicy, CancellationToken
+//!
+//! \return An std::future<value> that contains the value of the first successful
+//! attempt.
+template<class TFactory>
+std::future<retry_value_t<TFactory>> retry(std::shared_ptr<Executor> executor,
+                                           CancellationToken token,
+                                           RetryPolicy policy,
+                                           TFactory&& factory)
+{
+    using T = retry_value_t<TFactory>;
+
+    std::promise<T> p;
+
+    auto result = p.get_future();
+
+    auto w = std::make_unique<detail::FutureWithRetry<T, typename std::decay<TFactory>::type>>(
+        std::move(policy),
+        executor,
+        std::move(p),
+        std::forward<TFactory>(factory)
+    );
+
+    w->setCancellationToken(std::move(token));
+
+    executor->watch(std::move(w));
+
+    return result;
+}
+
+//! \brief Creates a future that becomes ready when one of the attempts made
+//! by the given factory succeeds.
+//!
+//! \param executor The object that waits for the attempts and the delays between them.
+//! \param policy The policy that determines the number of attempts, the delays
+//! between them and their total time limit.
+//! \param factory The function that starts an attempt, returning its std::future.
+//!
+//! \sa RetryPolicy
+//!
+//! \return An std::future<value> that contains the value of the first successful
+//! attempt.
+template<class TFactory>
+std::future<retry_value_t<TFactory>> retry(std::shared_ptr<Executor> executor,
+                                           RetryPolicy policy,
+                                           TFactory&& factory)
+{
+    return retry(std::move(executor),
+                 CancellationToken(),
+                 std::move(policy),
+                 std::forward<TFactory>(factory));
+}
+
+//! \brief Creates a future that becomes ready when one of the attempts made
+//! by the given factory succeeds.
+//!
+//! \par This function uses the default Executor object to wait for the attempts
+//! and the delays between them.
+//!
+//! \param policy The policy that determines the number of attempts, the delays
+//! between them and their total time limit.
+//! \param factory The function that starts an attempt, returning its std::future.
+//!
+//! \sa RetryPolicy, Default
+//!
+//! \return An std::future<value> that contains the value of the first successful
+//! attempt.
+template<class TFactory>
+std::future<retry_value_t<TFactory>> retry(RetryPolicy policy, TFactory&& factory)
+{
+    return retry(Default<Executor>(),
+                 std::move(policy),
+                 std::forward<TFactory>(factory));
+}
+
+} // namespace futures
+} // namespace thousandeyes
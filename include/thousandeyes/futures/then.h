@@ -12,10 +12,13 @@
 
 #include <future>
 #include <memory>
+#include <tuple>
 #include <type_traits>
+#include <vector>
 
 #include <thousandeyes/futures/detail/FutureWithContinuation.h>
 #include <thousandeyes/futures/detail/FutureWithChaining.h>
+#include <thousandeyes/futures/detail/FutureWithDependents.h>
 #include <thousandeyes/futures/detail/typetraits.h>
 
 #include <thousandeyes/futures/Default.h>
@@ -56,9 +59,11 @@ using cont_returns_value_t =
 //! \brief Creates a future that becomes ready when the input future becomes ready.
 //!
 //! \par The resulting future contains the value returned by invoking the given
-//! continuation function.
+//! continuation function. The input future is watched with the given priority.
 //!
 //! \param executor The object that waits for the given future to become ready.
+//! \param priority The priority class used by the executor for the input future.
+//! \param token The token used to cancel waiting for the input future.
 //! \param timeLimit The maximum time to wait for the given future to become ready.
 //! \param f The input future to wait and invoke the continuation function on.
 //! \param cont The continuation function to invoke on the ready input future.
@@ -67,13 +72,19 @@ using cont_returns_value_t =
 //! given timeLimit, the resulting future becomes ready with an exception of type
 //! WaitableTimedOutException.
 //!
-//! \sa WaitableTimedOutException
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa Priority, CancellationToken, WaitableTimedOutException, WaitableCancelledException
 //!
 //! \return An std::future<value> that contains the value returned by the given
 //! continuation function.
 template<class TIn, class TFunc>
 cont_returns_value_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
-                                      std::chrono::microseconds timeLimit,
+                                      Priority priority,
+                                      CancellationToken token,
+                                      std::chrono::nanoseconds timeLimit,
                                       std::future<TIn> f,
                                       TFunc&& cont)
 {
@@ -85,16 +96,155 @@ cont_returns_value_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
 
     auto result = p.get_future();
 
-    executor->watch(std::make_unique<detail::FutureWithContinuation<TIn, TOut, TFunc>>(
+    auto w = std::make_unique<detail::FutureWithContinuation<TIn, TOut, TFunc>>(
         std::move(timeLimit),
         std::move(f),
         std::move(p),
         std::forward<TFunc>(cont)
-    ));
+    );
+
+    w->setPriority(priority);
+    w->setCancellationToken(std::move(token));
+
+    executor->watch(std::move(w));
 
     return result;
 }
 
+//! \brief Creates a future that becomes ready when the input future becomes ready.
+//!
+//! \par The resulting future contains the value returned by invoking the given
+//! continuation function. The input future is watched with the given priority.
+//!
+//! \param executor The object that waits for the given future to become ready.
+//! \param priority The priority class used by the executor for the input future.
+//! \param timeLimit The maximum time to wait for the given future to become ready.
+//! \param f The input future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the input future to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa Priority, WaitableTimedOutException
+//!
+//! \return An std::future<value> that contains the value returned by the given
+//! continuation function.
+template<class TIn, class TFunc>
+cont_returns_value_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                      Priority priority,
+                                      std::chrono::nanoseconds timeLimit,
+                                      std::future<TIn> f,
+                                      TFunc&& cont)
+{
+    return then<TIn, TFunc>(std::move(executor),
+                            priority,
+                            CancellationToken(),
+                            std::move(timeLimit),
+                            std::move(f),
+                            std::forward<TFunc>(cont));
+}
+
+//! \brief Creates a future that becomes ready when the input future becomes ready.
+//!
+//! \par The resulting future contains the value returned by invoking the given
+//! continuation function.
+//!
+//! \param executor The object that waits for the given future to become ready.
+//! \param token The token used to cancel waiting for the input future.
+//! \param timeLimit The maximum time to wait for the given future to become ready.
+//! \param f The input future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the input future to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa CancellationToken, WaitableTimedOutException, WaitableCancelledException
+//!
+//! \return An std::future<value> that contains the value returned by the given
+//! continuation function.
+template<class TIn, class TFunc>
+cont_returns_value_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                      CancellationToken token,
+                                      std::chrono::nanoseconds timeLimit,
+                                      std::future<TIn> f,
+                                      TFunc&& cont)
+{
+    return then<TIn, TFunc>(std::move(executor),
+                            Priority::Normal,
+                            std::move(token),
+                            std::move(timeLimit),
+                            std::move(f),
+                            std::forward<TFunc>(cont));
+}
+
+//! \brief Creates a future that becomes ready when the input future becomes ready.
+//!
+//! \par The resulting future contains the value returned by invoking the given
+//! continuation function. The input future is watched with the given priority.
+//!
+//! \param executor The object that waits for the given future to become ready.
+//! \param priority The priority class used by the executor for the input future.
+//! \param f The input future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the input future to become ready exceeds
+//! a maximum threshold defined by the library (typically 1h), the resulting future
+//! becomes ready with an exception of type WaitableTimedOutException.
+//!
+//! \sa Priority, WaitableTimedOutException
+//!
+//! \return An std::future<value> that contains the value returned by the given
+//! continuation function.
+template<class TIn, class TFunc>
+cont_returns_value_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                      Priority priority,
+                                      std::future<TIn> f,
+                                      TFunc&& cont)
+{
+    return then<TIn, TFunc>(std::move(executor),
+                            priority,
+                            std::chrono::hours(1),
+                            std::move(f),
+                            std::forward<TFunc>(cont));
+}
+
+//! \brief Creates a future that becomes ready when the input future becomes ready.
+//!
+//! \par The resulting future contains the value returned by invoking the given
+//! continuation function.
+//!
+//! \param executor The object that waits for the given future to become ready.
+//! \param timeLimit The maximum time to wait for the given future to become ready.
+//! \param f The input future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the input future to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa WaitableTimedOutException
+//!
+//! \return An std::future<value> that contains the value returned by the given
+//! continuation function.
+template<class TIn, class TFunc>
+cont_returns_value_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                      std::chrono::nanoseconds timeLimit,
+                                      std::future<TIn> f,
+                                      TFunc&& cont)
+{
+    return then<TIn, TFunc>(std::move(executor),
+                            Priority::Normal,
+                            std::move(timeLimit),
+                            std::move(f),
+                            std::forward<TFunc>(cont));
+}
+
 //! \brief Creates a future that becomes ready when the input future becomes ready.
 //!
 //! \par The resulting future contains the value returned by invoking the given
@@ -143,7 +293,7 @@ cont_returns_value_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
 //! \return An std::future<value> that contains the value returned by the given
 //! continuation function.
 template<class TIn, class TFunc>
-cont_returns_value_t<TIn, TFunc> then(std::chrono::microseconds timeLimit,
+cont_returns_value_t<TIn, TFunc> then(std::chrono::nanoseconds timeLimit,
                                       std::future<TIn> f,
                                       TFunc&& cont)
 {
@@ -211,9 +361,12 @@ using cont_returns_future_t =
 //! continuation future become ready.
 //!
 //! \par The resulting future contains the value contained in the future obtained
-//! by invoking the given continuation function on the ready input future.
+//! by invoking the given continuation function on the ready input future. The
+//! futures are watched with the given priority.
 //!
 //! \param executor The object that waits for the futures to become ready.
+//! \param priority The priority class used by the executor for the futures.
+//! \param token The token used to cancel waiting for the futures.
 //! \param timeLimit The maximum time to wait for both futures to become ready.
 //! \param f The input future to wait and invoke the continuation function on.
 //! \param cont The continuation function to invoke on the ready input future.
@@ -222,13 +375,19 @@ using cont_returns_future_t =
 //! given timeLimit, the resulting future becomes ready with an exception of type
 //! WaitableTimedOutException.
 //!
-//! \sa WaitableTimedOutException
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa Priority, CancellationToken, WaitableTimedOutException, WaitableCancelledException
 //!
 //! \return An std::future<value> that contains the value contained in the future
 //! returned by the given continuation function.
 template<class TIn, class TFunc>
 cont_returns_future_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
-                                       std::chrono::microseconds timeLimit,
+                                       Priority priority,
+                                       CancellationToken token,
+                                       std::chrono::nanoseconds timeLimit,
                                        std::future<TIn> f,
                                        TFunc&& cont)
 {
@@ -243,17 +402,162 @@ cont_returns_future_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
 
     auto result = p.get_future();
 
-    executor->watch(std::make_unique<detail::FutureWithChaining<TIn, TOut, TFunc>>(
+    auto w = std::make_unique<detail::FutureWithChaining<TIn, TOut, TFunc>>(
         std::move(timeLimit),
         executor,
         std::move(f),
         std::move(p),
         std::forward<TFunc>(cont)
-    ));
+    );
+
+    w->setPriority(priority);
+    w->setCancellationToken(std::move(token));
+
+    executor->watch(std::move(w));
 
     return result;
 }
 
+//! \brief Creates a future that becomes ready when both the input future and the
+//! continuation future become ready.
+//!
+//! \par The resulting future contains the value contained in the future obtained
+//! by invoking the given continuation function on the ready input future. The
+//! futures are watched with the given priority.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param priority The priority class used by the executor for the futures.
+//! \param timeLimit The maximum time to wait for both futures to become ready.
+//! \param f The input future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa Priority, WaitableTimedOutException
+//!
+//! \return An std::future<value> that contains the value contained in the future
+//! returned by the given continuation function.
+template<class TIn, class TFunc>
+cont_returns_future_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                       Priority priority,
+                                       std::chrono::nanoseconds timeLimit,
+                                       std::future<TIn> f,
+                                       TFunc&& cont)
+{
+    return then<TIn, TFunc>(std::move(executor),
+                            priority,
+                            CancellationToken(),
+                            std::move(timeLimit),
+                            std::move(f),
+                            std::forward<TFunc>(cont));
+}
+
+//! \brief Creates a future that becomes ready when both the input future and the
+//! continuation future become ready.
+//!
+//! \par The resulting future contains the value contained in the future obtained
+//! by invoking the given continuation function on the ready input future.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param token The token used to cancel waiting for the futures.
+//! \param timeLimit The maximum time to wait for both futures to become ready.
+//! \param f The input future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa CancellationToken, WaitableTimedOutException, WaitableCancelledException
+//!
+//! \return An std::future<value> that contains the value contained in the future
+//! returned by the given continuation function.
+template<class TIn, class TFunc>
+cont_returns_future_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                       CancellationToken token,
+                                       std::chrono::nanoseconds timeLimit,
+                                       std::future<TIn> f,
+                                       TFunc&& cont)
+{
+    return then<TIn, TFunc>(std::move(executor),
+                            Priority::Normal,
+                            std::move(token),
+                            std::move(timeLimit),
+                            std::move(f),
+                            std::forward<TFunc>(cont));
+}
+
+//! \brief Creates a future that becomes ready when both the input future and the
+//! continuation future become ready.
+//!
+//! \par The resulting future contains the value contained in the future obtained
+//! by invoking the given continuation function on the ready input future. The
+//! futures are watched with the given priority.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param priority The priority class used by the executor for the futures.
+//! \param f The input future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the input future to become ready exceeds
+//! a maximum threshold defined by the library (typically 1h), the resulting future
+//! becomes ready with an exception of type WaitableTimedOutException.
+//!
+//! \sa Priority, WaitableTimedOutException
+//!
+//! \return An std::future<value> that contains the value contained in the future
+//! returned by the given continuation function.
+template<class TIn, class TFunc>
+cont_returns_future_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                       Priority priority,
+                                       std::future<TIn> f,
+                                       TFunc&& cont)
+{
+    return then<TIn, TFunc>(std::move(executor),
+                            priority,
+                            std::chrono::hours(1),
+                            std::move(f),
+                            std::forward<TFunc>(cont));
+}
+
+//! \brief Creates a future that becomes ready when both the input future and the
+//! continuation future become ready.
+//!
+//! \par The resulting future contains the value contained in the future obtained
+//! by invoking the given continuation function on the ready input future.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param timeLimit The maximum time to wait for both futures to become ready.
+//! \param f The input future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa WaitableTimedOutException
+//!
+//! \return An std::future<value> that contains the value contained in the future
+//! returned by the given continuation function.
+template<class TIn, class TFunc>
+cont_returns_future_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                       std::chrono::nanoseconds timeLimit,
+                                       std::future<TIn> f,
+                                       TFunc&& cont)
+{
+    return then<TIn, TFunc>(std::move(executor),
+                            Priority::Normal,
+                            std::move(timeLimit),
+                            std::move(f),
+                            std::forward<TFunc>(cont));
+}
+
 //! \brief Creates a future that becomes ready when both the input future and the
 //! continuation future become ready.
 //!
@@ -305,7 +609,7 @@ cont_returns_future_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
 //! \return An std::future<value> that contains the value contained in the future
 //! returned by the given continuation function.
 template<class TIn, class TFunc>
-cont_returns_future_t<TIn, TFunc> then(std::chrono::microseconds timeLimit,
+cont_returns_future_t<TIn, TFunc> then(std::chrono::nanoseconds timeLimit,
                                        std::future<TIn> f,
                                        TFunc&& cont)
 {
@@ -344,5 +648,392 @@ cont_returns_future_t<TIn, TFunc> then(std::future<TIn> f,
                             std::forward<TFunc>(cont));
 }
 
+//! \brief Meta-type that resolves to the future returned by attaching the given
+//! continuation to an std::shared_future.
+//!
+//! \note Like the continuations attached to an std::future, a continuation that
+//! returns an std::future<value> results in an std::future<value>.
+template<class TIn, class TFunc>
+using shared_cont_result_t = detail::shared_cont_future_t<TIn, TFunc>;
+
+//! \brief Creates one future per given continuation function, each becoming ready
+//! when the input shared future becomes ready.
+//!
+//! \par Each resulting future contains the value returned by invoking the
+//! corresponding continuation function on the ready input shared future, or, if the
+//! continuation function returns a future, the value contained in that future. The
+//! executor waits for the shared state once, with a single #Waitable object watched
+//! with the given priority, and invokes all the continuation functions together.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param priority The priority class used by the executor for the futures.
+//! \param token The token used to cancel waiting for the futures.
+//! \param timeLimit The maximum time to wait for the futures to become ready.
+//! \param f The input shared future to wait and invoke the continuation functions on.
+//! \param conts The continuation functions to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds the
+//! given timeLimit, the resulting futures become ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \note If the cancellation of the given token is requested before the resulting
+//! futures become ready, they become ready with an exception of type
+//! WaitableCancelledException.
+//!
+//! \sa then(), Priority, CancellationToken, WaitableTimedOutException,
+//! WaitableCancelledException
+//!
+//! \return An std::tuple of std::future<value> objects that contain the values returned
+//! by the given continuation functions, in the same order.
+template<class TIn, class... TFuncs>
+std::tuple<shared_cont_result_t<TIn, TFuncs>...> fanOut(std::shared_ptr<Executor> executor,
+                                                        Priority priority,
+                                                        CancellationToken token,
+                                                        std::chrono::nanoseconds timeLimit,
+                                                        std::shared_future<TIn> f,
+                                                        TFuncs&&... conts)
+{
+    std::vector<std::unique_ptr<detail::Dependent<TIn>>> dependents;
+    dependents.reserve(sizeof...(TFuncs));
+
+    std::weak_ptr<Executor> weak = executor;
+
+    // The braced initialization adds the dependents in the given order
+    std::tuple<shared_cont_result_t<TIn, TFuncs>...> result{
+        detail::addDependent<TIn>(dependents, weak, std::forward<TFuncs>(conts))...
+    };
+
+    auto w = std::make_unique<detail::FutureWithDependents<TIn>>(
+        std::move(timeLimit),
+        std::move(f),
+        std::move(dependents)
+    );
+
+    w->setPriority(priority);
+    w->setCancellationToken(std::move(token));
+
+    executor->watch(std::move(w));
+
+    return result;
+}
+
+//! \brief Creates one future per given continuation function, each becoming ready
+//! when the input shared future becomes ready.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param timeLimit The maximum time to wait for the futures to become ready.
+//! \param f The input shared future to wait and invoke the continuation functions on.
+//! \param conts The continuation functions to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds the
+//! given timeLimit, all the resulting futures become ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa then(), WaitableTimedOutException
+//!
+//! \return An std::tuple of std::future<value> objects that contain the values returned
+//! by the given continuation functions, in the same order.
+template<class TIn, class... TFuncs>
+std::tuple<shared_cont_result_t<TIn, TFuncs>...> fanOut(std::shared_ptr<Executor> executor,
+                                                        std::chrono::nanoseconds timeLimit,
+                                                        std::shared_future<TIn> f,
+                                                        TFuncs&&... conts)
+{
+    return fanOut(std::move(executor),
+                  Priority::Normal,
+                  CancellationToken(),
+                  std::move(timeLimit),
+                  std::move(f),
+                  std::forward<TFuncs>(conts)...);
+}
+
+//! \brief Creates one future per given continuation function, each becoming ready
+//! when the input shared future becomes ready.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param f The input shared future to wait and invoke the continuation functions on.
+//! \param conts The continuation functions to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds
+//! a maximum threshold defined by the library (typically 1h), all the resulting futures
+//! become ready with an exception of type WaitableTimedOutException.
+//!
+//! \sa then(), WaitableTimedOutException
+//!
+//! \return An std::tuple of std::future<value> objects that contain the values returned
+//! by the given continuation functions, in the same order.
+template<class TIn, class... TFuncs>
+std::tuple<shared_cont_result_t<TIn, TFuncs>...> fanOut(std::shared_ptr<Executor> executor,
+                                                        std::shared_future<TIn> f,
+                                                        TFuncs&&... conts)
+{
+    return fanOut(std::move(executor),
+                  std::chrono::hours(1),
+                  std::move(f),
+                  std::forward<TFuncs>(conts)...);
+}
+
+//! \brief Creates one future per given continuation function, each becoming ready
+//! when the input shared future becomes ready.
+//!
+//! \par This function uses the default Executor object to wait for the futures
+//! to become ready.
+//!
+//! \param f The input shared future to wait and invoke the continuation functions on.
+//! \param conts The continuation functions to invoke on the ready input future.
+//!
+//! \sa then(), Default, WaitableTimedOutException
+//!
+//! \return An std::tuple of std::future<value> objects that contain the values returned
+//! by the given continuation functions, in the same order.
+template<class TIn, class... TFuncs>
+std::tuple<shared_cont_result_t<TIn, TFuncs>...> fanOut(std::shared_future<TIn> f,
+                                                        TFuncs&&... conts)
+{
+    return fanOut(Default<Executor>(),
+                  std::chrono::hours(1),
+                  std::move(f),
+                  std::forward<TFuncs>(conts)...);
+}
+
+//! \brief Creates a future that becomes ready when the input shared future becomes ready.
+//!
+//! \par The resulting future contains the value returned by invoking the given
+//! continuation function on the ready input shared future, or, if the continuation
+//! function returns a future, the value contained in that future. The futures are
+//! watched with the given priority. To attach many continuations to the same shared
+//! future, fanOut() waits for the shared state only once.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param priority The priority class used by the executor for the futures.
+//! \param token The token used to cancel waiting for the futures.
+//! \param timeLimit The maximum time to wait for the futures to become ready.
+//! \param f The input shared future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa fanOut(), Priority, CancellationToken, WaitableTimedOutException,
+//! WaitableCancelledException
+//!
+//! \return An std::future<value> that contains the value returned by the given
+//! continuation function.
+template<class TIn, class TFunc>
+shared_cont_result_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                      Priority priority,
+                                      CancellationToken token,
+                                      std::chrono::nanoseconds timeLimit,
+                                      std::shared_future<TIn> f,
+                                      TFunc&& cont)
+{
+    return std::get<0>(fanOut(std::move(executor),
+                              priority,
+                              std::move(token),
+                              std::move(timeLimit),
+                              std::move(f),
+                              std::forward<TFunc>(cont)));
+}
+
+//! \brief Creates a future that becomes ready when the input shared future becomes ready.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param priority The priority class used by the executor for the futures.
+//! \param timeLimit The maximum time to wait for the futures to become ready.
+//! \param f The input shared future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa fanOut(), Priority, WaitableTimedOutException
+//!
+//! \return An std::future<value> that contains the value returned by the given
+//! continuation function.
+template<class TIn, class TFunc>
+shared_cont_result_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                      Priority priority,
+                                      std::chrono::nanoseconds timeLimit,
+                                      std::shared_future<TIn> f,
+                                      TFunc&& cont)
+{
+    return then(std::move(executor),
+                priority,
+                CancellationToken(),
+                std::move(timeLimit),
+                std::move(f),
+                std::forward<TFunc>(cont));
+}
+
+//! \brief Creates a future that becomes ready when the input shared future becomes ready.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param token The token used to cancel waiting for the futures.
+//! \param timeLimit The maximum time to wait for the futures to become ready.
+//! \param f The input shared future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \sa fanOut(), CancellationToken, WaitableTimedOutException, WaitableCancelledException
+//!
+//! \return An std::future<value> that contains the value returned by the given
+//! continuation function.
+template<class TIn, class TFunc>
+shared_cont_result_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                      CancellationToken token,
+                                      std::chrono::nanoseconds timeLimit,
+                                      std::shared_future<TIn> f,
+                                      TFunc&& cont)
+{
+    return then(std::move(executor),
+                Priority::Normal,
+                std::move(token),
+                std::move(timeLimit),
+                std::move(f),
+                std::forward<TFunc>(cont));
+}
+
+//! \brief Creates a future that becomes ready when the input shared future becomes ready.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param priority The priority class used by the executor for the futures.
+//! \param f The input shared future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds
+//! a maximum threshold defined by the library (typically 1h), the resulting future
+//! becomes ready with an exception of type WaitableTimedOutException.
+//!
+//! \sa fanOut(), Priority, WaitableTimedOutException
+//!
+//! \return An std::future<value> that contains the value returned by the given
+//! continuation function.
+template<class TIn, class TFunc>
+shared_cont_result_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                      Priority priority,
+                                      std::shared_future<TIn> f,
+                                      TFunc&& cont)
+{
+    return then(std::move(executor),
+                priority,
+                CancellationToken(),
+                std::chrono::hours(1),
+                std::move(f),
+                std::forward<TFunc>(cont));
+}
+
+//! \brief Creates a future that becomes ready when the input shared future becomes ready.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param timeLimit The maximum time to wait for the futures to become ready.
+//! \param f The input shared future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds the
+//! given timeLimit, the resulting future becomes ready with an exception of type
+//! WaitableTimedOutException.
+//!
+//! \sa fanOut(), WaitableTimedOutException
+//!
+//! \return An std::future<value> that contains the value returned by the given
+//! continuation function.
+template<class TIn, class TFunc>
+shared_cont_result_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                      std::chrono::nanoseconds timeLimit,
+                                      std::shared_future<TIn> f,
+                                      TFunc&& cont)
+{
+    return then(std::move(executor),
+                Priority::Normal,
+                CancellationToken(),
+                std::move(timeLimit),
+                std::move(f),
+                std::forward<TFunc>(cont));
+}
+
+//! \brief Creates a future that becomes ready when the input shared future becomes ready.
+//!
+//! \param executor The object that waits for the futures to become ready.
+//! \param f The input shared future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \note If the total time for waiting the futures to become ready exceeds
+//! a maximum threshold defined by the library (typically 1h), the resulting future
+//! becomes ready with an exception of type WaitableTimedOutException.
+//!
+//! \sa fanOut(), WaitableTimedOutException
+//!
+//! \return An std::future<value> that contains the value returned by the given
+//! continuation function.
+template<class TIn, class TFunc>
+shared_cont_result_t<TIn, TFunc> then(std::shared_ptr<Executor> executor,
+                                      std::shared_future<TIn> f,
+                                      TFunc&& cont)
+{
+    return then(std::move(executor),
+                std::chrono::hours(1),
+                std::move(f),
+                std::forward<TFunc>(cont));
+}
+
+//! \brief Creates a future that becomes ready when the input shared future becomes ready.
+//!
+//! \par This function uses the default Executor object to wait for the futures
+//! to become ready.
+//!
+//! \param timeLimit The maximum time to wait for the futures to become ready.
+//! \param f The input shared future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \sa fanOut(), Default, WaitableTimedOutException
+//!
+//! \return An std::future<value> that contains the value returned by the given
+//! continuation function.
+template<class TIn, class TFunc>
+shared_cont_result_t<TIn, TFunc> then(std::chrono::nanoseconds timeLimit,
+                                      std::shared_future<TIn> f,
+                                      TFunc&& cont)
+{
+    return then(Default<Executor>(),
+                std::move(timeLimit),
+                std::move(f),
+                std::forward<TFunc>(cont));
+}
+
+//! \brief Creates a future that becomes ready when the input shared future becomes ready.
+//!
+//! \par This function uses the default Executor object to wait for the futures
+//! to become ready.
+//!
+//! \param f The input shared future to wait and invoke the continuation function on.
+//! \param cont The continuation function to invoke on the ready input future.
+//!
+//! \sa fanOut(), Default, WaitableTimedOutException
+//!
+//! \return An std::future<value> that contains the value returned by the given
+//! continuation function.
+template<class TIn, class TFunc>
+shared_cont_result_t<TIn, TFunc> then(std::shared_future<TIn> f,
+                                      TFunc&& cont)
+{
+    return then(Default<Executor>(),
+                std::chrono::hours(1),
+                std::move(f),
+                std::forward<TFunc>(cont));
+}
+
 } // namespace futures
 } // namespace thousandeyes
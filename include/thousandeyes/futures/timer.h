@@ -0,0 +1,141 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <memory>
+
+#include <thousandeyes/futures/detail/Timer.h>
+
+#include <thousandeyes/futures/CancellationToken.h>
+#include <thousandeyes/futures/Default.h>
+#include <thousandeyes/futures/Executor.h>
+
+namespace thousandeyes {
+namespace futures {
+
+//! \brief Creates a future that becomes ready at the given time point.
+//!
+//! \par The timer is a #Waitable watched by the given executor, so pending
+//! timers do not occupy any threads and their futures can be passed to then()
+//! and all() like any other future.
+//!
+//! \param executor The object that waits for the given time point.
+//! \param token The token used to cancel the timer.
+//! \param deadline The time point at which the resulting future becomes ready.
+//!
+//! \note If the cancellation of the given token is requested before the resulting
+//! future becomes ready, the resulting future becomes ready with an exception of
+//! type WaitableCancelledException.
+//!
+//! \note The resulting future becomes ready the first time the executor polls the
+//! timer after the given time point. The #PollingExecutor polls the expired #Waitable
+//! objects at the start of each sweep, and a sweep can wait up to one polling quantum
+//! on each of the N watched #Waitable objects, so the delay can grow to about N x q.
+//!
+//! \sa CancellationToken, WaitableCancelledException
+//!
+//! \return An std::future<void> that becomes ready at the given time point.
+inline std::future<void> at(std::shared_ptr<Executor> executor,
+                            CancellationToken token,
+                            std::chrono::steady_clock::time_point deadline)
+{
+    std::promise<void> p;
+
+    auto result = p.get_future();
+
+    auto w = std::make_unique<detail::Timer>(std::move(deadline), std::move(p));
+
+    w->setCancellationToken(std::move(token));
+
+    executor->watch(std::move(w));
+
+    return result;
+}
+
+//! \brief Creates a future that becomes ready at the given time point.
+//!
+//! \param executor The object that waits for the given time point.
+//! \param deadline The time point at which the resulting future becomes ready.
+//!
+//! \return An std::future<void> that becomes ready at the given time point.
+inline std::future<void> at(std::shared_ptr<Executor> executor,
+                            std::chrono::steady_clock::time_point deadline)
+{
+    return at(std::move(executor), CancellationToken(), std::move(deadline));
+}
+
+//! \brief Creates a future that becomes ready at the given time point.
+//!
+//! \par This function uses the default Executor object to wait for the given
+//! time point.
+//!
+//! \param deadline The time point at which the resulting future becomes ready.
+//!
+//! \sa Default
+//!
+//! \return An std::future<void> that becomes ready at the given time point.
+inline std::future<void> at(std::chrono::steady_clock::time_point deadline)
+{
+    return at(Default<Executor>(), std::move(deadline));
+}
+
+//! \brief Creates a future that becomes ready after the given duration.
+//!
+//! \param executor The object that waits for the given duration to pass.
+//! \param token The token used to cancel the timer.
+//! \param delay The duration after which the resulting future becomes ready.
+//!
+//! \sa at(), CancellationToken
+//!
+//! \return An std::future<void> that becomes ready after the given duration.
+inline std::future<void> after(std::shared_ptr<Executor> executor,
+                               CancellationToken token,
+                               std::chrono::nanoseconds delay)
+{
+    auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay);
+
+    return at(std::move(executor), std::move(token), deadline);
+}
+
+//! \brief Creates a future that becomes ready after the given duration.
+//!
+//! \param executor The object that waits for the given duration to pass.
+//! \param delay The duration after which the resulting future becomes ready.
+//!
+//! \sa at()
+//!
+//! \return An std::future<void> that becomes ready after the given duration.
+inline std::future<void> after(std::shared_ptr<Executor> executor,
+                               std::chrono::nanoseconds delay)
+{
+    return after(std::move(executor), CancellationToken(), std::move(delay));
+}
+
+//! \brief Creates a future that becomes ready after the given duration.
+//!
+//! \par This function uses the default Executor object to wait for the given
+//! duration to pass.
+//!
+//! \param delay The duration after which the resulting future becomes ready.
+//!
+//! \sa at(), Default
+//!
+//! \return An std::future<void> that becomes ready after the given duration.
+inline std::future<void> after(std::chrono::nanoseconds delay)
+{
+    return after(Default<Executor>(), std::move(delay));
+}
+
+} // namespace futures
+} // namespace thousandeyes
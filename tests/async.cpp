@@ -0,0 +1,172 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/Future.h>
+#include <thousandeyes/futures/async.h>
+
+using std::make_shared;
+using std::set;
+using std::thread;
+using std::vector;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+using thousandeyes::futures::CancellationSource;
+using thousandeyes::futures::DefaultExecutor;
+using thousandeyes::futures::Future;
+using thousandeyes::futures::WaitableCancelledException;
+using thousandeyes::futures::WaitableWaitException;
+using thousandeyes::futures::then;
+
+namespace futures = thousandeyes::futures;
+
+using ::testing::Test;
+
+class AsyncTest : public Test {
+protected:
+    AsyncTest() :
+        executor_(make_shared<DefaultExecutor>(milliseconds(10)))
+    {}
+
+    ~AsyncTest()
+    {
+        executor_->stop();
+    }
+
+    std::shared_ptr<DefaultExecutor> executor_;
+};
+
+TEST_F(AsyncTest, RunOnExecutorThread)
+{
+    auto f = futures::async(executor_, []() {
+        return std::this_thread::get_id();
+    });
+
+    EXPECT_NE(std::this_thread::get_id(), f.get());
+}
+
+TEST_F(AsyncTest, ReuseThreads)
+{
+    std::mutex m;
+    set<thread::id> ids;
+
+    vector<Future<void>> results;
+    for (int i = 0; i < 1000; ++i) {
+        results.push_back(futures::async(executor_, [&m, &ids]() {
+            std::lock_guard<std::mutex> lock(m);
+            ids.insert(std::this_thread::get_id());
+        }));
+    }
+
+    for (auto& f: results) {
+        f.get();
+    }
+
+    EXPECT_LE(ids.size(), std::max(1u, thread::hardware_concurrency()));
+}
+
+TEST_F(AsyncTest, ThenWithoutPolling)
+{
+    std::atomic<bool> isDone{ false };
+
+    auto f = futures::async(executor_, [&isDone]() {
+        while (!isDone) {
+            std::this_thread::yield();
+        }
+
+        return 1821;
+    });
+
+    auto g = then(std::move(f), [](Future<int> f) {
+        return f.get() + 1;
+    });
+
+    isDone = true;
+
+    EXPECT_EQ(1822, g.get());
+}
+
+TEST_F(AsyncTest, ThrowException)
+{
+    auto f = futures::async(executor_, []() -> int {
+        throw std::runtime_error("failed");
+    });
+
+    EXPECT_THROW(f.get(), std::runtime_error);
+}
+
+TEST_F(AsyncTest, CancelBeforeStart)
+{
+    CancellationSource source;
+    source.cancel();
+
+    bool isRun = false;
+
+    auto f = futures::async(executor_, source.token(), [&isRun]() {
+        isRun = true;
+    });
+
+    EXPECT_THROW(f.get(), WaitableCancelledException);
+    EXPECT_FALSE(isRun);
+}
+
+TEST_F(AsyncTest, DrainPostedWork)
+{
+    auto f = futures::async(executor_, []() {
+        std::this_thread::sleep_for(milliseconds(50));
+        return 1821;
+    });
+
+    EXPECT_TRUE(executor_->drain(steady_clock::now() + milliseconds(5000)));
+    EXPECT_TRUE(f.isReady());
+    EXPECT_EQ(1821, f.get());
+
+    auto g = futures::async(executor_, []() {
+        return 1822;
+    });
+
+    EXPECT_THROW(g.get(), WaitableWaitException);
+}
+
+TEST_F(AsyncTest, RunQueuedWorkOnDestruction)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+
+    // More functions than threads, so that some are still queued
+    int count = 4 * static_cast<int>(std::max(1u, thread::hardware_concurrency()));
+
+    vector<Future<int>> results;
+    for (int i = 0; i < count; ++i) {
+        results.push_back(futures::async(executor, [i]() {
+            std::this_thread::sleep_for(milliseconds(5));
+            return i;
+        }));
+    }
+
+    executor->stop();
+    executor.reset();
+
+    for (int i = 0; i < count; ++i) {
+        EXPECT_EQ(i, results[i].get());
+    }
+}
@@ -38,6 +38,7 @@ using std::function;
 using std::future;
 using std::future_status;
 using std::promise;
+using std::shared_future;
 using std::map;
 using std::make_shared;
 using std::make_unique;
@@ -65,13 +66,19 @@ using std::chrono::microseconds;
 using std::chrono::duration_cast;
 using std::this_thread::sleep_for;
 
+using thousandeyes::futures::CancellationSource;
 using thousandeyes::futures::Default;
 using thousandeyes::futures::DefaultExecutor;
 using thousandeyes::futures::Executor;
+using thousandeyes::futures::OverflowPolicy;
+using thousandeyes::futures::Priority;
 using thousandeyes::futures::Waitable;
+using thousandeyes::futures::WaitableCancelledException;
 using thousandeyes::futures::WaitableWaitException;
 using thousandeyes::futures::then;
 using thousandeyes::futures::all;
+using thousandeyes::futures::allValues;
+using thousandeyes::futures::fanOut;
 using thousandeyes::futures::fromValue;
 using thousandeyes::futures::fromException;
 
@@ -841,6 +848,224 @@ future<int> recFunc2(future<int> f)
 
 } // namespace
 
+TEST_F(DefaultExecutorTest, ContainerAllValuesWithoutException)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+    Default<Executor>::Setter execSetter(executor);
+
+    vector<future<int>> futures;
+    for (int i = 0; i < 1821; ++i) {
+        futures.push_back(getValueAsync(i));
+    }
+
+    auto values = allValues(move(futures)).get();
+
+    ASSERT_EQ(1821u, values.size());
+    for (int i = 0; i < 1821; ++i) {
+        EXPECT_EQ(i, values[i]);
+    }
+
+    executor->stop();
+}
+
+TEST_F(DefaultExecutorTest, ContainerAllValuesFailFast)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+
+    promise<int> pending;
+
+    vector<future<int>> futures;
+    futures.push_back(pending.get_future());
+    futures.push_back(getExceptionAsync<int, SomeKindOfError>());
+
+    auto f = allValues(executor, move(futures));
+
+    // Ready without waiting for the pending future
+    EXPECT_EQ(future_status::ready, f.wait_for(milliseconds(1000)));
+    EXPECT_THROW(f.get(), SomeKindOfError);
+
+    executor->stop();
+}
+
+TEST_F(DefaultExecutorTest, TupleAllValues)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+    Default<Executor>::Setter execSetter(executor);
+
+    auto t = allValues(getValueAsync(1821),
+                       getValueAsync(string("1822")),
+                       getValueAsync(true)).get();
+
+    EXPECT_EQ(get<0>(t), 1821);
+    EXPECT_EQ(get<1>(t), "1822");
+    EXPECT_EQ(get<2>(t), true);
+
+    promise<string> pending;
+
+    auto f = allValues(getValueAsync(1821),
+                       pending.get_future(),
+                       getExceptionAsync<bool, SomeKindOfError>());
+
+    EXPECT_EQ(future_status::ready, f.wait_for(milliseconds(1000)));
+    EXPECT_THROW(f.get(), SomeKindOfError);
+
+    executor->stop();
+}
+
+TEST_F(DefaultExecutorTest, ThenWithSharedFuture)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+    Default<Executor>::Setter execSetter(executor);
+
+    shared_future<int> f = getValueAsync(1821).share();
+
+    auto g = then(f, [](shared_future<int> f) {
+        return to_string(f.get());
+    });
+
+    auto h = then(executor, f, [](shared_future<int> f) {
+        return f.get() + 1;
+    });
+
+    EXPECT_EQ("1821", g.get());
+    EXPECT_EQ(1822, h.get());
+
+    executor->stop();
+}
+
+TEST_F(DefaultExecutorTest, ThenWithSharedFutureReturningFuture)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+
+    promise<int> p;
+    shared_future<int> f = p.get_future().share();
+
+    auto g = then(executor, f, [](shared_future<int> f) {
+        return getValueAsync(to_string(f.get()));
+    });
+
+    static_assert(std::is_same<future<string>, decltype(g)>::value,
+                  "The continuation's future is unwrapped");
+
+    auto results = fanOut(executor, f,
+        [](shared_future<int> f) {
+            return getValueAsync(f.get() + 1);
+        },
+        [](shared_future<int> f) {
+            return f.get() + 2;
+        });
+
+    p.set_value(1821);
+
+    EXPECT_EQ("1821", g.get());
+    EXPECT_EQ(1822, get<0>(results).get());
+    EXPECT_EQ(1823, get<1>(results).get());
+
+    executor->stop();
+}
+
+TEST_F(DefaultExecutorTest, ThenWithSharedFutureAndOptions)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+
+    CancellationSource source;
+    promise<int> p;
+    shared_future<int> f = p.get_future().share();
+
+    auto g = then(executor, Priority::High, f, [](shared_future<int> f) {
+        return f.get() + 1;
+    });
+
+    auto h = then(executor, source.token(), hours(1), f, [](shared_future<int> f) {
+        return to_string(f.get());
+    });
+
+    auto k = then(executor, Priority::Low, source.token(), hours(1), f,
+                  [](shared_future<int> f) {
+                      return getValueAsync(f.get() + 2);
+                  });
+
+    source.cancel();
+
+    EXPECT_THROW(h.get(), WaitableCancelledException);
+    EXPECT_THROW(k.get(), WaitableCancelledException);
+
+    p.set_value(1821);
+
+    EXPECT_EQ(1822, g.get());
+
+    executor->stop();
+}
+
+TEST_F(DefaultExecutorTest, FanOutSharedFuture)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+
+    promise<int> p;
+    shared_future<int> f = p.get_future().share();
+
+    auto results = fanOut(executor, f,
+        [](shared_future<int> f) {
+            return f.get() + 1;
+        },
+        [](shared_future<int> f) {
+            return to_string(f.get());
+        },
+        [](shared_future<int> f) {
+            f.get();
+        });
+
+    p.set_value(1821);
+
+    EXPECT_EQ(1822, get<0>(results).get());
+    EXPECT_EQ("1821", get<1>(results).get());
+    EXPECT_NO_THROW(get<2>(results).get());
+
+    executor->stop();
+}
+
+TEST_F(DefaultExecutorTest, FanOutSharedFutureWithException)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+
+    shared_future<int> f = getExceptionAsync<int, SomeKindOfError>().share();
+
+    auto results = fanOut(executor, f,
+        [](shared_future<int> f) {
+            return f.get();
+        },
+        [](shared_future<int> f) {
+            return f.valid();
+        });
+
+    EXPECT_THROW(get<0>(results).get(), SomeKindOfError);
+    EXPECT_TRUE(get<1>(results).get());
+
+    executor->stop();
+}
+
+TEST_F(DefaultExecutorTest, ContainerAllWithSharedFutures)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+    Default<Executor>::Setter execSetter(executor);
+
+    shared_future<int> f = getValueAsync(1821).share();
+
+    vector<shared_future<int>> futures{ f, f, getValueAsync(1).share() };
+
+    auto g = then(all(move(futures)), [](future<vector<shared_future<int>>> f) {
+        int sum = 0;
+        for (const auto& s: f.get()) {
+            sum += s.get();
+        }
+        return sum;
+    });
+
+    EXPECT_EQ(3643, g.get());
+
+    executor->stop();
+}
+
 TEST_F(DefaultExecutorTest, MutuallyRecursiveFunctionsCreateDependentFutures)
 {
     auto executor = make_shared<DefaultExecutor>(milliseconds(10));
@@ -871,3 +1096,130 @@ TEST_F(DefaultExecutorTest, ThenAfterStop)
     EXPECT_THROW(f.get(), WaitableWaitException);
     EXPECT_THROW(g.get(), WaitableWaitException);
 }
+
+TEST_F(DefaultExecutorTest, BoundedExecutorBlocksWatchWhenFull)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10), 1, OverflowPolicy::Block);
+    Default<Executor>::Setter execSetter(executor);
+
+    promise<int> p0;
+    auto f0 = then(p0.get_future(), [](future<int> f) {
+        return to_string(f.get());
+    });
+
+    std::atomic<bool> watched{ false };
+    auto f1 = std::async(std::launch::async, [&watched]() {
+        auto result = then(getValueAsync(1822), [](future<int> f) {
+            return to_string(f.get());
+        });
+        watched = true;
+        return result.get();
+    });
+
+    sleep_for(milliseconds(50));
+    EXPECT_FALSE(watched);
+
+    p0.set_value(1821);
+
+    EXPECT_EQ("1821", f0.get());
+    EXPECT_EQ("1822", f1.get());
+    EXPECT_TRUE(watched);
+
+    executor->stop();
+}
+
+TEST_F(DefaultExecutorTest, ThenAndAllWithPriority)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+
+    auto f = then(executor, Priority::High, getValueAsync(1821), [](future<int> f) {
+        return to_string(f.get());
+    });
+
+    auto g = then(executor, Priority::Low, hours(1), getValueAsync(1822), [](future<int> f) {
+        return to_string(f.get());
+    });
+
+    auto h = all(executor, Priority::High, hours(1), getValueAsync(1823), getValueAsync(1824));
+
+    EXPECT_EQ("1821", f.get());
+    EXPECT_EQ("1822", g.get());
+
+    auto values = h.get();
+    EXPECT_EQ(1823, get<0>(values).get());
+    EXPECT_EQ(1824, get<1>(values).get());
+
+    executor->stop();
+}
+
+TEST_F(DefaultExecutorTest, ThenAndAllWithCancellationToken)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+
+    CancellationSource source;
+    promise<int> p0;
+    promise<int> p1;
+
+    auto f = then(executor, source.token(), hours(1), p0.get_future(), [](future<int> f) {
+        return to_string(f.get());
+    });
+
+    auto g = all(executor, source.token(), hours(1), p1.get_future(), getValueAsync(1822));
+
+    auto h = then(executor, source.token(), hours(1), getValueAsync(1823), [](future<int> f) {
+        return to_string(f.get());
+    });
+
+    EXPECT_EQ("1823", h.get());
+
+    source.cancel();
+
+    EXPECT_THROW(f.get(), WaitableCancelledException);
+    EXPECT_THROW(g.get(), WaitableCancelledException);
+
+    executor->stop();
+}
+
+TEST_F(DefaultExecutorTest, DrainDispatchesPendingWaitables)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+
+    promise<int> p;
+    auto f = then(executor, p.get_future(), [executor](future<int> f) {
+        // Chained from within the executor, so it is accepted while draining
+        return then(executor, fromValue(f.get()), [](future<int> f) {
+            return to_string(f.get());
+        });
+    });
+
+    auto drained = std::async(std::launch::async, [executor]() {
+        return executor->drain(std::chrono::steady_clock::now() + seconds(10));
+    });
+
+    sleep_for(milliseconds(50));
+
+    auto g = then(executor, getValueAsync(1822), [](future<int> f) {
+        return to_string(f.get());
+    });
+
+    EXPECT_THROW(g.get(), WaitableWaitException);
+
+    p.set_value(1821);
+
+    EXPECT_EQ("1821", f.get());
+    EXPECT_TRUE(drained.get());
+}
+
+TEST_F(DefaultExecutorTest, DrainCancelsWaitablesAfterDeadline)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+
+    promise<int> p;
+    auto f = then(executor, p.get_future(), [](future<int> f) {
+        return to_string(f.get());
+    });
+
+    EXPECT_FALSE(executor->drain(std::chrono::steady_clock::now() + milliseconds(50)));
+
+    EXPECT_THROW(f.get(), WaitableWaitException);
+}
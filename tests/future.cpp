@@ -0,0 +1,236 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/Future.h>
+#include <thousandeyes/futures/all.h>
+#include <thousandeyes/futures/then.h>
+
+using std::future_error;
+using std::future_status;
+using std::make_shared;
+using std::string;
+using std::thread;
+using std::vector;
+using std::chrono::milliseconds;
+
+using thousandeyes::futures::DefaultExecutor;
+using thousandeyes::futures::Future;
+using thousandeyes::futures::Promise;
+using thousandeyes::futures::all;
+using thousandeyes::futures::fromStdFuture;
+using thousandeyes::futures::then;
+using thousandeyes::futures::toStdFuture;
+
+using ::testing::Test;
+
+TEST(FutureTest, SetValueBeforeGet)
+{
+    Promise<string> p;
+    auto f = p.get_future();
+
+    EXPECT_FALSE(f.isReady());
+
+    p.set_value("ready");
+
+    EXPECT_TRUE(f.isReady());
+    EXPECT_EQ("ready", f.get());
+    EXPECT_FALSE(f.valid());
+}
+
+TEST(FutureTest, SetValueFromAnotherThread)
+{
+    Promise<int> p;
+    auto f = p.get_future();
+
+    EXPECT_EQ(future_status::timeout, f.wait_for(milliseconds(1)));
+
+    thread t([p = std::move(p)]() mutable {
+        std::this_thread::sleep_for(milliseconds(10));
+        p.set_value(1821);
+    });
+
+    EXPECT_EQ(1821, f.get());
+
+    t.join();
+}
+
+TEST(FutureTest, ConcurrentWaiters)
+{
+    Promise<int> p;
+    auto f = p.get_future();
+
+    // A timed out wait does not leave anything behind for set_value() to notify
+    EXPECT_EQ(future_status::timeout, f.wait_for(milliseconds(1)));
+
+    thread t0([&f]() {
+        f.wait();
+    });
+
+    thread t1([&f]() {
+        while (f.wait_for(milliseconds(1)) == future_status::timeout) {}
+    });
+
+    std::this_thread::sleep_for(milliseconds(10));
+    p.set_value(1821);
+
+    t0.join();
+    t1.join();
+
+    EXPECT_EQ(1821, f.get());
+}
+
+TEST(FutureTest, SetException)
+{
+    Promise<void> p;
+    auto f = p.get_future();
+
+    p.set_exception(std::make_exception_ptr(std::runtime_error("failed")));
+
+    EXPECT_THROW(f.get(), std::runtime_error);
+}
+
+TEST(FutureTest, BrokenPromiseAndRetrievedFuture)
+{
+    Future<int> f;
+
+    {
+        Promise<int> p;
+        f = p.get_future();
+
+        EXPECT_THROW(p.get_future(), future_error);
+    }
+
+    EXPECT_THROW(f.get(), future_error);
+
+    Promise<int> p;
+    p.set_value(1);
+    EXPECT_THROW(p.set_value(2), future_error);
+}
+
+TEST(FutureTest, ThenWithoutPolling)
+{
+    Promise<int> p;
+
+    auto f = then(p.get_future(), [](Future<int> f) {
+        return std::to_string(f.get());
+    });
+
+    auto g = then(std::move(f), [](Future<string> f) {
+        return f.get() + "!";
+    });
+
+    EXPECT_FALSE(g.isReady());
+
+    // The continuations are invoked by the thread that sets the value
+    p.set_value(1821);
+
+    EXPECT_TRUE(g.isReady());
+    EXPECT_EQ("1821!", g.get());
+
+    // The continuation of a ready future is invoked right away
+    Promise<void> q;
+    q.set_value();
+
+    auto h = then(q.get_future(), [](Future<void>) {});
+
+    EXPECT_TRUE(h.isReady());
+}
+
+TEST(FutureTest, ThenWithException)
+{
+    Promise<int> p;
+
+    auto f = then(p.get_future(), [](Future<int> f) {
+        f.get();
+        throw std::logic_error("never");
+    });
+
+    auto g = then(std::move(f), [](Future<void> f) {
+        try {
+            f.get();
+            return string();
+        }
+        catch (const std::runtime_error& e) {
+            return string(e.what());
+        }
+    });
+
+    p.set_exception(std::make_exception_ptr(std::runtime_error("failed")));
+
+    EXPECT_EQ("failed", g.get());
+}
+
+TEST(FutureTest, AllWithoutPolling)
+{
+    vector<Promise<int>> promises(1000);
+
+    vector<Future<int>> futures;
+    for (auto& p: promises) {
+        futures.push_back(p.get_future());
+    }
+
+    auto f = all(std::move(futures));
+
+    vector<thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&promises, i]() {
+            for (std::size_t j = i; j < promises.size(); j += 4) {
+                promises[j].set_value(static_cast<int>(j));
+            }
+        });
+    }
+
+    auto result = f.get();
+
+    for (auto& t: threads) {
+        t.join();
+    }
+
+    ASSERT_EQ(1000, result.size());
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(static_cast<int>(i), result[i].get());
+    }
+
+    auto g = all(vector<Future<int>>());
+
+    EXPECT_TRUE(g.isReady());
+    EXPECT_TRUE(g.get().empty());
+}
+
+TEST(FutureTest, ConvertToAndFromStdFuture)
+{
+    auto executor = make_shared<DefaultExecutor>(milliseconds(10));
+
+    std::promise<int> p;
+
+    auto f = fromStdFuture(executor, p.get_future());
+
+    auto g = toStdFuture(then(std::move(f), [](Future<int> f) {
+        return f.get() * 2;
+    }));
+
+    p.set_value(21);
+
+    EXPECT_EQ(42, g.get());
+
+    executor->stop();
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/hedge.h>
+#include <thousandeyes/futures/util.h>
+
+using std::atomic;
+using std::future;
+using std::future_status;
+using std::make_shared;
+using std::promise;
+using std::runtime_error;
+using std::vector;
+using std::chrono::hours;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+using thousandeyes::futures::CancellationSource;
+using thousandeyes::futures::DefaultExecutor;
+using thousandeyes::futures::WaitableCancelledException;
+using thousandeyes::futures::WaitableTimedOutException;
+using thousandeyes::futures::fromException;
+using thousandeyes::futures::fromValue;
+using thousandeyes::futures::hedge;
+
+using ::testing::Test;
+
+class HedgeTest : public Test {
+protected:
+    HedgeTest() :
+        executor_(make_shared<DefaultExecutor>(milliseconds(10)))
+    {}
+
+    ~HedgeTest()
+    {
+        executor_->stop();
+    }
+
+    std::shared_ptr<DefaultExecutor> executor_;
+};
+
+TEST_F(HedgeTest, FirstAttemptSucceeds)
+{
+    atomic<int> attempts{ 0 };
+
+    auto f = hedge(executor_, hours(1), 3, [&attempts]() {
+        ++attempts;
+        return fromValue(1821);
+    });
+
+    EXPECT_EQ(1821, f.get());
+    EXPECT_EQ(1, attempts);
+}
+
+TEST_F(HedgeTest, LaunchAttemptAfterDelay)
+{
+    // Outlives the executor, so that the abandoned attempt never becomes ready
+    auto slow = make_shared<promise<int>>();
+
+    atomic<int> attempts{ 0 };
+
+    auto t0 = steady_clock::now();
+
+    auto f = hedge(executor_, milliseconds(20), 3, [&attempts, slow]() {
+        if (++attempts == 1) {
+            return slow->get_future();
+        }
+        return fromValue(1822);
+    });
+
+    EXPECT_EQ(1822, f.get());
+    EXPECT_EQ(2, attempts);
+    EXPECT_GE(steady_clock::now() - t0, milliseconds(20));
+}
+
+TEST_F(HedgeTest, ReplaceFailedAttempts)
+{
+    atomic<int> attempts{ 0 };
+
+    auto f = hedge(executor_, hours(1), 3, [&attempts]() {
+        if (++attempts < 3) {
+            return fromException<int>(std::make_exception_ptr(runtime_error("failed")));
+        }
+        return fromValue(1823);
+    });
+
+    EXPECT_EQ(future_status::ready, f.wait_for(milliseconds(1000)));
+    EXPECT_EQ(1823, f.get());
+    EXPECT_EQ(3, attempts);
+}
+
+TEST_F(HedgeTest, AllAttemptsFail)
+{
+    atomic<int> attempts{ 0 };
+
+    auto f = hedge(executor_, milliseconds(1), 3, [&attempts]() -> future<void> {
+        throw runtime_error("failed " + std::to_string(++attempts));
+    });
+
+    try {
+        f.get();
+        FAIL();
+    }
+    catch (const runtime_error& e) {
+        EXPECT_STREQ("failed 3", e.what());
+    }
+}
+
+TEST_F(HedgeTest, TimeOut)
+{
+    vector<promise<int>> pending(2);
+    atomic<int> attempts{ 0 };
+
+    auto f = hedge(executor_, CancellationSource().token(), milliseconds(50), milliseconds(10), 2,
+                   [&pending, &attempts]() {
+        return pending[attempts++].get_future();
+    });
+
+    EXPECT_THROW(f.get(), WaitableTimedOutException);
+    EXPECT_EQ(2, attempts);
+}
+
+TEST_F(HedgeTest, Cancel)
+{
+    CancellationSource source;
+    promise<int> pending;
+
+    auto f = hedge(executor_, source.token(), hours(1), hours(1), 2, [&pending]() {
+        return pending.get_future();
+    });
+
+    source.cancel();
+
+    EXPECT_EQ(future_status::ready, f.wait_for(milliseconds(1000)));
+    EXPECT_THROW(f.get(), WaitableCancelledException);
+}
@@ -0,0 +1,348 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/PollingExecutor.h>
+#include <thousandeyes/futures/then.h>
+#include <thousandeyes/futures/detail/InvokerWithNewThread.h>
+#include <thousandeyes/futures/detail/InvokerWithTimeBudget.h>
+
+using std::function;
+using std::future;
+using std::make_shared;
+using std::move;
+using std::promise;
+using std::shared_ptr;
+using std::string;
+using std::thread;
+using std::to_string;
+using std::vector;
+using std::chrono::milliseconds;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+using std::this_thread::sleep_for;
+
+using thousandeyes::futures::InlineDispatchExecutor;
+using thousandeyes::futures::PollingExecutor;
+using thousandeyes::futures::then;
+using thousandeyes::futures::detail::InvokerWithNewThread;
+using thousandeyes::futures::detail::InvokerWithTimeBudget;
+
+using ::testing::Invoke;
+using ::testing::Test;
+using ::testing::_;
+
+namespace {
+
+class Invoker {
+public:
+    MOCK_METHOD1(invoke, void(function<void()> f));
+};
+
+class FallbackFunctor {
+public:
+    explicit FallbackFunctor(shared_ptr<Invoker> invoker) :
+        invoker_(move(invoker))
+    {}
+
+    void operator()(function<void()> f)
+    {
+        invoker_->invoke(move(f));
+    }
+
+private:
+    shared_ptr<Invoker> invoker_;
+};
+
+class PollFunctor {
+public:
+    PollFunctor() :
+        invoker_(make_shared<InvokerWithNewThread>())
+    {}
+
+    void operator()(function<void()> f)
+    {
+        (*invoker_)(move(f));
+    }
+
+private:
+    shared_ptr<InvokerWithNewThread> invoker_;
+};
+
+void spinFor(microseconds d)
+{
+    auto until = steady_clock::now() + d;
+    while (steady_clock::now() < until) {}
+}
+
+} // namespace
+
+TEST(InvokerWithTimeBudgetTest, FirstFunctionsFallBack)
+{
+    auto fallback = make_shared<Invoker>();
+    InvokerWithTimeBudget<FallbackFunctor> invoker(milliseconds(10), FallbackFunctor(fallback));
+
+    function<void()> offloaded;
+    EXPECT_CALL(*fallback, invoke(_))
+        .WillOnce(::testing::SaveArg<0>(&offloaded));
+
+    // Not measured yet, so it may block the calling thread
+    bool called = false;
+    invoker([&called]() {
+        called = true;
+    });
+
+    EXPECT_FALSE(called);
+
+    offloaded();
+
+    EXPECT_TRUE(called);
+}
+
+TEST(InvokerWithTimeBudgetTest, CheapFunctionsRunInline)
+{
+    auto fallback = make_shared<Invoker>();
+    InvokerWithTimeBudget<FallbackFunctor> invoker(milliseconds(10), FallbackFunctor(fallback));
+
+    int offloaded = 0;
+    EXPECT_CALL(*fallback, invoke(_))
+        .WillRepeatedly(Invoke([&offloaded](function<void()> f) {
+            ++offloaded;
+            f();
+        }));
+
+    int count = 0;
+    for (int i = 0; i < 10; ++i) {
+        invoker([&count]() {
+            ++count;
+        });
+    }
+
+    EXPECT_EQ(10, count);
+    EXPECT_LT(0, offloaded);
+    EXPECT_GT(10, offloaded);
+
+    // Once measured cheap, they all run inline
+    auto measured = offloaded;
+    for (int i = 0; i < 10; ++i) {
+        invoker([&count]() {
+            ++count;
+        });
+    }
+
+    EXPECT_EQ(20, count);
+    EXPECT_EQ(measured, offloaded);
+}
+
+TEST(InvokerWithTimeBudgetTest, ExpensiveFunctionsFallBack)
+{
+    auto fallback = make_shared<Invoker>();
+    InvokerWithTimeBudget<FallbackFunctor> invoker(microseconds(100), FallbackFunctor(fallback));
+
+    vector<function<void()>> offloaded;
+    EXPECT_CALL(*fallback, invoke(_))
+        .WillRepeatedly(Invoke([&offloaded](function<void()> f) {
+            offloaded.push_back(move(f));
+        }));
+
+    // Measured cheap by the fallback until the average is within the budget
+    while (offloaded.size() < 100) {
+        auto count = offloaded.size();
+        invoker([]() {});
+
+        if (offloaded.size() == count) {
+            break;
+        }
+
+        offloaded.back()();
+    }
+
+    ASSERT_GT(100U, offloaded.size());
+    offloaded.clear();
+
+    // Runs inline, but exceeds the budget by far
+    invoker([]() {
+        sleep_for(milliseconds(20));
+    });
+
+    EXPECT_TRUE(offloaded.empty());
+
+    bool called = false;
+    invoker([&called]() {
+        called = true;
+    });
+
+    EXPECT_FALSE(called);
+    ASSERT_EQ(1U, offloaded.size());
+
+    offloaded.front()();
+
+    EXPECT_TRUE(called);
+}
+
+TEST(InvokerWithTimeBudgetTest, CheapFunctionsReturnInline)
+{
+    auto fallback = make_shared<Invoker>();
+    InvokerWithTimeBudget<FallbackFunctor> invoker(microseconds(100), FallbackFunctor(fallback));
+
+    int offloaded = 0;
+    EXPECT_CALL(*fallback, invoke(_))
+        .WillRepeatedly(Invoke([&offloaded](function<void()> f) {
+            ++offloaded;
+            f();
+        }));
+
+    invoker([]() {
+        sleep_for(milliseconds(2));
+    });
+
+    // The average decays as cheap functions are measured by the fallback
+    int inlined = 0;
+    for (int i = 0; i < 100; ++i) {
+        invoker([]() {});
+        ++inlined;
+    }
+
+    EXPECT_EQ(100, inlined);
+    EXPECT_LT(0, offloaded);
+    EXPECT_GT(100, offloaded);
+}
+
+TEST(InvokerWithTimeBudgetTest, CheapBatchesRunInline)
+{
+    auto fallback = make_shared<Invoker>();
+    InvokerWithTimeBudget<FallbackFunctor> invoker(microseconds(100), FallbackFunctor(fallback));
+
+    int offloaded = 0;
+    EXPECT_CALL(*fallback, invoke(_))
+        .WillRepeatedly(Invoke([&offloaded](function<void()> f) {
+            ++offloaded;
+            f();
+        }));
+
+    for (int i = 0; i < 100; ++i) {
+        invoker([]() {});
+    }
+
+    auto measured = offloaded;
+
+    // The batch exceeds the budget, but each of its continuations is cheap
+    invoker([]() {
+        sleep_for(milliseconds(2));
+    }, 1000);
+
+    bool called = false;
+    invoker([&called]() {
+        called = true;
+    });
+
+    EXPECT_TRUE(called);
+    EXPECT_EQ(measured, offloaded);
+}
+
+TEST(InvokerWithTimeBudgetTest, CheapContinuationsReadyTogetherStayInline)
+{
+    using Executor = PollingExecutor<
+        PollFunctor,
+        InvokerWithTimeBudget<FallbackFunctor>
+    >;
+
+    auto fallback = make_shared<Invoker>();
+
+    int offloaded = 0;
+    EXPECT_CALL(*fallback, invoke(_))
+        .WillRepeatedly(Invoke([&offloaded](function<void()> f) {
+            ++offloaded;
+            f();
+        }));
+
+    auto executor = make_shared<Executor>(
+        milliseconds(10),
+        PollFunctor(),
+        InvokerWithTimeBudget<FallbackFunctor>(milliseconds(1), FallbackFunctor(fallback))
+    );
+
+    auto cheap = [](future<int> f) {
+        return f.get();
+    };
+
+    // Measured cheap by the fallback until the average is within the budget
+    for (int i = 0; i < 100; ++i) {
+        promise<int> p;
+        auto result = then(executor, p.get_future(), cheap);
+        p.set_value(i);
+        EXPECT_EQ(i, result.get());
+    }
+
+    auto measured = offloaded;
+
+    // Together, the continuations exceed the budget by far
+    vector<promise<int>> promises(500);
+    vector<future<int>> results;
+    for (auto& p: promises) {
+        results.push_back(then(executor, p.get_future(), [](future<int> f) {
+            spinFor(microseconds(20));
+            return f.get();
+        }));
+    }
+
+    for (int i = 0; i < 500; ++i) {
+        promises[i].set_value(i);
+    }
+
+    for (int i = 0; i < 500; ++i) {
+        EXPECT_EQ(i, results[i].get());
+    }
+
+    promise<int> p;
+    auto result = then(executor, p.get_future(), cheap);
+    p.set_value(42);
+    EXPECT_EQ(42, result.get());
+
+    EXPECT_EQ(measured, offloaded);
+
+    executor->stop();
+}
+
+TEST(InvokerWithTimeBudgetTest, ThenWithInlineDispatchExecutor)
+{
+    auto executor = make_shared<InlineDispatchExecutor>(milliseconds(10));
+
+    vector<promise<int>> promises(100);
+    vector<future<string>> results;
+    for (auto& p: promises) {
+        results.push_back(then(executor, p.get_future(), [](future<int> f) {
+            return to_string(f.get());
+        }));
+    }
+
+    thread([&promises]() {
+        for (int i = 0; i < 100; ++i) {
+            promises[i].set_value(i);
+        }
+    }).join();
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(to_string(i), results[i].get());
+    }
+
+    executor->stop();
+}
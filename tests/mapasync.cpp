@@ -0,0 +1,147 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/mapAsync.h>
+#include <thousandeyes/futures/util.h>
+
+using std::atomic;
+using std::future;
+using std::list;
+using std::make_shared;
+using std::runtime_error;
+using std::string;
+using std::thread;
+using std::vector;
+using std::chrono::milliseconds;
+using std::chrono::microseconds;
+using std::this_thread::sleep_for;
+
+using thousandeyes::futures::DefaultExecutor;
+using thousandeyes::futures::WaitableTimedOutException;
+using thousandeyes::futures::fromValue;
+using thousandeyes::futures::mapAsync;
+
+using ::testing::Test;
+
+class MapAsyncTest : public Test {
+protected:
+    MapAsyncTest() :
+        executor_(make_shared<DefaultExecutor>(milliseconds(1)))
+    {}
+
+    ~MapAsyncTest()
+    {
+        executor_->stop();
+    }
+
+    std::shared_ptr<DefaultExecutor> executor_;
+};
+
+TEST_F(MapAsyncTest, KeepOrder)
+{
+    vector<int> input(100);
+    for (int i = 0; i < 100; ++i) {
+        input[i] = i;
+    }
+
+    auto f = mapAsync(executor_, 8, input, [](int i) {
+        return fromValue(std::to_string(i));
+    });
+
+    auto results = f.get();
+
+    ASSERT_EQ(100u, results.size());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(std::to_string(i), results[i].get());
+    }
+}
+
+TEST_F(MapAsyncTest, BoundInFlightFutures)
+{
+    atomic<int> inFlight{ 0 };
+    atomic<int> maxInFlight{ 0 };
+
+    list<int> input(50, 1);
+
+    auto f = mapAsync(executor_, 4, std::move(input), [&inFlight, &maxInFlight](int i) {
+        int n = ++inFlight;
+        int m = maxInFlight;
+        while (n > m && !maxInFlight.compare_exchange_weak(m, n)) {}
+
+        return std::async(std::launch::async, [&inFlight, i]() {
+            sleep_for(milliseconds(2));
+            --inFlight;
+            return i;
+        });
+    });
+
+    int sum = 0;
+    for (auto& r: f.get()) {
+        sum += r.get();
+    }
+
+    EXPECT_EQ(50, sum);
+    EXPECT_LE(maxInFlight, 4);
+    EXPECT_GE(maxInFlight, 1);
+}
+
+TEST_F(MapAsyncTest, KeepFailedFutures)
+{
+    vector<int> input{ 0, 1, 2 };
+
+    auto f = mapAsync(executor_, 2, input, [](int i) -> future<void> {
+        if (i == 1) {
+            throw runtime_error("failed");
+        }
+        return fromValue();
+    });
+
+    auto results = f.get();
+
+    ASSERT_EQ(3u, results.size());
+    EXPECT_NO_THROW(results[0].get());
+    EXPECT_THROW(results[1].get(), runtime_error);
+    EXPECT_NO_THROW(results[2].get());
+}
+
+TEST_F(MapAsyncTest, EmptyInput)
+{
+    auto f = mapAsync(executor_, 2, vector<int>(), [](int i) {
+        return fromValue(i);
+    });
+
+    EXPECT_TRUE(f.get().empty());
+}
+
+TEST_F(MapAsyncTest, TimeOut)
+{
+    vector<std::promise<int>> pending(2);
+
+    auto f = mapAsync(executor_, milliseconds(20), 2, vector<int>{ 0, 1 }, [&pending](int i) {
+        return pending[i].get_future();
+    });
+
+    EXPECT_THROW(f.get(), WaitableTimedOutException);
+}
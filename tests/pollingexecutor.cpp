@@ -30,17 +30,25 @@ using std::unique_ptr;
 using std::weak_ptr;
 using std::string;
 using std::runtime_error;
+using std::size_t;
 using std::chrono::hours;
 using std::chrono::minutes;
 using std::chrono::seconds;
 using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
 using std::chrono::microseconds;
 using std::chrono::duration_cast;
 
+using thousandeyes::futures::CancellationSource;
+using thousandeyes::futures::ExecutorOverflowException;
+using thousandeyes::futures::OverflowPolicy;
 using thousandeyes::futures::PollingExecutor;
+using thousandeyes::futures::Priority;
 using thousandeyes::futures::Waitable;
+using thousandeyes::futures::WaitableCancelledException;
 using thousandeyes::futures::WaitableTimedOutException;
 using thousandeyes::futures::TimedWaitable;
+using thousandeyes::futures::toTimestamp;
 
 using ::testing::AtLeast;
 using ::testing::IsNull;
@@ -60,6 +68,31 @@ public:
     MOCK_METHOD1(dispatch, void(std::exception_ptr err));
 };
 
+class TimestampedWaitableMock : public Waitable {
+public:
+    MOCK_METHOD1(wait, bool(const std::chrono::microseconds& timeout));
+
+    MOCK_METHOD2(wait, bool(const std::chrono::microseconds& timeout,
+                            const std::chrono::nanoseconds& timestamp));
+
+    MOCK_METHOD1(dispatch, void(std::exception_ptr err));
+};
+
+class ExpiredWaitableMock : public Waitable {
+public:
+    // The earliest possible deadline that is set
+    ExpiredWaitableMock() :
+        Waitable(nanoseconds(1))
+    {}
+
+    MOCK_METHOD1(wait, bool(const std::chrono::microseconds& timeout));
+
+    MOCK_METHOD2(wait, bool(const std::chrono::microseconds& timeout,
+                            const std::chrono::nanoseconds& timestamp));
+
+    MOCK_METHOD1(dispatch, void(std::exception_ptr err));
+};
+
 class Invoker {
 public:
     MOCK_METHOD1(invoke, void(function<void()> f));
@@ -87,6 +120,13 @@ public:
     {}
 };
 
+class BoundedExecutor : public PollingExecutor<DispatcherFunctor, DispatcherFunctor> {
+public:
+    BoundedExecutor(milliseconds q, shared_ptr<Invoker> d, size_t capacity, OverflowPolicy policy) :
+        PollingExecutor(move(q), DispatcherFunctor(d), DispatcherFunctor(d), capacity, policy)
+    {}
+};
+
 } // namespace
 
 class PollingExecutorTest : public Test {
@@ -142,3 +182,366 @@ TEST_F(PollingExecutorTest, ThrowingWaitable)
     f(); // Poll
     g(); // Dispatch
 }
+
+TEST_F(PollingExecutorTest, PollExpiredWaitablesFirst)
+{
+    auto w0 = make_unique<WaitableMock>();
+    auto w1 = make_unique<ExpiredWaitableMock>();
+    auto w2 = make_unique<ExpiredWaitableMock>();
+
+    {
+        ::testing::InSequence seq;
+
+        EXPECT_CALL(*w1, wait(_, _))
+            .WillOnce(Throw(WaitableTimedOutException("Timed out")));
+
+        EXPECT_CALL(*w2, wait(_, _))
+            .WillOnce(Throw(WaitableTimedOutException("Timed out")));
+
+        EXPECT_CALL(*w0, wait(microseconds(0)))
+            .WillOnce(Return(false));
+
+        EXPECT_CALL(*w0, wait(microseconds(10000)))
+            .WillOnce(Return(true));
+    }
+
+    EXPECT_CALL(*w0, dispatch(IsNull()))
+        .Times(1);
+
+    EXPECT_CALL(*w1, dispatch(NotNull()))
+        .Times(1);
+
+    EXPECT_CALL(*w2, dispatch(NotNull()))
+        .Times(1);
+
+    function<void()> f, g, h;
+    EXPECT_CALL(*invoker_, invoke(_))
+        .WillOnce(SaveArg<0>(&f))
+        .WillOnce(SaveArg<0>(&g))
+        .WillOnce(SaveArg<0>(&h));
+
+    poller_->watch(move(w0));
+    poller_->watch(move(w1));
+    poller_->watch(move(w2));
+
+    f(); // Poll
+    g(); // Dispatch w1 and w2
+    h(); // Dispatch w0
+}
+
+TEST_F(PollingExecutorTest, DispatchReadyWaitablesInBatches)
+{
+    auto w0 = make_unique<WaitableMock>();
+    auto w1 = make_unique<WaitableMock>();
+    auto w2 = make_unique<WaitableMock>();
+
+    {
+        ::testing::InSequence seq;
+
+        EXPECT_CALL(*w0, wait(microseconds(10000)))
+            .WillOnce(Return(true));
+
+        // Checked without blocking since w0 is pending dispatch
+        EXPECT_CALL(*w1, wait(microseconds(0)))
+            .WillOnce(Return(true));
+
+        EXPECT_CALL(*w2, wait(microseconds(0)))
+            .WillOnce(Return(false));
+
+        EXPECT_CALL(*w2, wait(microseconds(10000)))
+            .WillOnce(Return(true));
+    }
+
+    EXPECT_CALL(*w0, dispatch(IsNull()))
+        .Times(1);
+
+    EXPECT_CALL(*w1, dispatch(IsNull()))
+        .Times(1);
+
+    EXPECT_CALL(*w2, dispatch(IsNull()))
+        .Times(1);
+
+    function<void()> f, g, h;
+    EXPECT_CALL(*invoker_, invoke(_))
+        .WillOnce(SaveArg<0>(&f))
+        .WillOnce(SaveArg<0>(&g))
+        .WillOnce(SaveArg<0>(&h));
+
+    poller_->watch(move(w0));
+    poller_->watch(move(w1));
+    poller_->watch(move(w2));
+
+    f(); // Poll
+    g(); // Dispatch w0 and w1
+    h(); // Dispatch w2
+}
+
+TEST_F(PollingExecutorTest, RejectWaitableWhenFull)
+{
+    auto poller = make_shared<BoundedExecutor>(milliseconds(10), invoker_, 1, OverflowPolicy::Reject);
+
+    auto w0 = make_unique<WaitableMock>();
+    auto w1 = make_unique<WaitableMock>();
+
+    EXPECT_CALL(*w0, wait(microseconds(10000)))
+        .WillOnce(Return(true));
+
+    EXPECT_CALL(*w0, dispatch(IsNull()))
+        .Times(1);
+
+    std::exception_ptr error;
+    EXPECT_CALL(*w1, dispatch(NotNull()))
+        .WillOnce(SaveArg<0>(&error));
+
+    function<void()> f, g, h;
+    EXPECT_CALL(*invoker_, invoke(_))
+        .WillOnce(SaveArg<0>(&f))
+        .WillOnce(SaveArg<0>(&g))
+        .WillOnce(SaveArg<0>(&h));
+
+    poller->watch(move(w0));
+    poller->watch(move(w1));
+
+    g(); // Dispatch rejected w1
+    f(); // Poll
+    h(); // Dispatch w0
+
+    EXPECT_THROW(std::rethrow_exception(error), ExecutorOverflowException);
+}
+
+TEST_F(PollingExecutorTest, ShedOldestWaitableWhenFull)
+{
+    auto poller = make_shared<BoundedExecutor>(milliseconds(10), invoker_, 1, OverflowPolicy::ShedOldest);
+
+    auto w0 = make_unique<WaitableMock>();
+    auto w1 = make_unique<WaitableMock>();
+
+    std::exception_ptr error;
+    EXPECT_CALL(*w0, dispatch(NotNull()))
+        .WillOnce(SaveArg<0>(&error));
+
+    EXPECT_CALL(*w1, wait(microseconds(10000)))
+        .WillOnce(Return(true));
+
+    EXPECT_CALL(*w1, dispatch(IsNull()))
+        .Times(1);
+
+    function<void()> f, g, h;
+    EXPECT_CALL(*invoker_, invoke(_))
+        .WillOnce(SaveArg<0>(&f))
+        .WillOnce(SaveArg<0>(&g))
+        .WillOnce(SaveArg<0>(&h));
+
+    poller->watch(move(w0));
+    poller->watch(move(w1));
+
+    g(); // Dispatch shed w0
+    f(); // Poll
+    h(); // Dispatch w1
+
+    EXPECT_THROW(std::rethrow_exception(error), ExecutorOverflowException);
+}
+
+TEST_F(PollingExecutorTest, TryWatchReportsRejection)
+{
+    auto poller = make_shared<BoundedExecutor>(milliseconds(10), invoker_, 1, OverflowPolicy::Block);
+
+    unique_ptr<Waitable> w0 = make_unique<WaitableMock>();
+    unique_ptr<Waitable> w1 = make_unique<WaitableMock>();
+
+    auto& w0Mock = static_cast<WaitableMock&>(*w0);
+
+    EXPECT_CALL(w0Mock, wait(microseconds(10000)))
+        .WillOnce(Return(true));
+
+    EXPECT_CALL(w0Mock, dispatch(IsNull()))
+        .Times(1);
+
+    function<void()> f, g;
+    EXPECT_CALL(*invoker_, invoke(_))
+        .WillOnce(SaveArg<0>(&f))
+        .WillOnce(SaveArg<0>(&g));
+
+    EXPECT_TRUE(poller->tryWatch(w0));
+    EXPECT_FALSE(poller->tryWatch(w1));
+
+    EXPECT_EQ(nullptr, w0);
+    EXPECT_NE(nullptr, w1);
+
+    f(); // Poll
+    g(); // Dispatch w0
+}
+
+TEST_F(PollingExecutorTest, PollHigherPriorityWaitablesFirst)
+{
+    auto low = make_unique<WaitableMock>();
+    auto normal = make_unique<WaitableMock>();
+    auto high = make_unique<WaitableMock>();
+
+    low->setPriority(Priority::Low);
+    high->setPriority(Priority::High);
+
+    {
+        ::testing::InSequence seq;
+
+        EXPECT_CALL(*high, wait(microseconds(10000)))
+            .WillOnce(Return(true));
+
+        EXPECT_CALL(*normal, wait(microseconds(0)))
+            .WillOnce(Return(true));
+
+        EXPECT_CALL(*low, wait(microseconds(0)))
+            .WillOnce(Return(true));
+
+        EXPECT_CALL(*high, dispatch(IsNull()));
+        EXPECT_CALL(*normal, dispatch(IsNull()));
+        EXPECT_CALL(*low, dispatch(IsNull()));
+    }
+
+    function<void()> f, g;
+    EXPECT_CALL(*invoker_, invoke(_))
+        .WillOnce(SaveArg<0>(&f))
+        .WillOnce(SaveArg<0>(&g));
+
+    poller_->watch(move(low));
+    poller_->watch(move(normal));
+    poller_->watch(move(high));
+
+    f(); // Poll
+    g(); // Dispatch high, normal and low
+}
+
+TEST_F(PollingExecutorTest, PollStarvedLowPriorityWaitables)
+{
+    auto low = make_unique<WaitableMock>();
+    auto high = make_unique<WaitableMock>();
+
+    low->setPriority(Priority::Low);
+    high->setPriority(Priority::High);
+
+    {
+        ::testing::InSequence seq;
+
+        // The low priority waitable is passed over 16 times in a row at most
+        EXPECT_CALL(*high, wait(microseconds(10000)))
+            .Times(16)
+            .WillRepeatedly(Return(false));
+
+        EXPECT_CALL(*low, wait(microseconds(10000)))
+            .WillOnce(Return(true));
+
+        EXPECT_CALL(*high, wait(microseconds(0)))
+            .WillOnce(Return(true));
+
+        EXPECT_CALL(*high, dispatch(IsNull()));
+        EXPECT_CALL(*low, dispatch(IsNull()));
+    }
+
+    function<void()> f, g;
+    EXPECT_CALL(*invoker_, invoke(_))
+        .WillOnce(SaveArg<0>(&f))
+        .WillOnce(SaveArg<0>(&g));
+
+    poller_->watch(move(low));
+    poller_->watch(move(high));
+
+    f(); // Poll
+    g(); // Dispatch high and low
+}
+
+TEST_F(PollingExecutorTest, DispatchCancelledWaitableWithoutWaiting)
+{
+    auto waitable = make_unique<WaitableMock>();
+
+    CancellationSource source;
+    waitable->setCancellationToken(source.token());
+
+    EXPECT_CALL(*waitable, wait(_))
+        .Times(0);
+
+    std::exception_ptr error;
+    EXPECT_CALL(*waitable, dispatch(NotNull()))
+        .WillOnce(SaveArg<0>(&error));
+
+    function<void()> f, g;
+    EXPECT_CALL(*invoker_, invoke(_))
+        .WillOnce(SaveArg<0>(&f))
+        .WillOnce(SaveArg<0>(&g));
+
+    poller_->watch(move(waitable));
+
+    source.cancel();
+
+    f(); // Poll
+    g(); // Dispatch
+
+    EXPECT_THROW(std::rethrow_exception(error), WaitableCancelledException);
+}
+
+TEST_F(PollingExecutorTest, CancelPendingWaitablesInBulkOnStop)
+{
+    auto w0 = make_unique<WaitableMock>();
+    auto w1 = make_unique<WaitableMock>();
+    auto w2 = make_unique<WaitableMock>();
+
+    std::exception_ptr e0, e1, e2;
+    EXPECT_CALL(*w0, dispatch(NotNull()))
+        .WillOnce(SaveArg<0>(&e0));
+
+    EXPECT_CALL(*w1, dispatch(NotNull()))
+        .WillOnce(SaveArg<0>(&e1));
+
+    EXPECT_CALL(*w2, dispatch(NotNull()))
+        .WillOnce(SaveArg<0>(&e2));
+
+    function<void()> f, g;
+    EXPECT_CALL(*invoker_, invoke(_))
+        .WillOnce(SaveArg<0>(&f))
+        .WillOnce(SaveArg<0>(&g));
+
+    poller_->watch(move(w0));
+    poller_->watch(move(w1));
+    poller_->watch(move(w2));
+
+    poller_->stop();
+
+    g(); // Dispatch all the cancelled waitables
+    f(); // Poll
+
+    // All the cancelled waitables share the same error
+    EXPECT_EQ(e0, e1);
+    EXPECT_EQ(e1, e2);
+}
+
+TEST_F(PollingExecutorTest, ReadClockOncePerSweep)
+{
+    auto w0 = make_unique<TimestampedWaitableMock>();
+    auto w1 = make_unique<TimestampedWaitableMock>();
+
+    nanoseconds t0, t1;
+    {
+        ::testing::InSequence seq;
+
+        EXPECT_CALL(*w0, wait(microseconds(10000), _))
+            .WillOnce(::testing::DoAll(SaveArg<1>(&t0), Return(true)));
+
+        EXPECT_CALL(*w1, wait(microseconds(0), _))
+            .WillOnce(::testing::DoAll(SaveArg<1>(&t1), Return(true)));
+    }
+
+    EXPECT_CALL(*w0, dispatch(IsNull()));
+    EXPECT_CALL(*w1, dispatch(IsNull()));
+
+    function<void()> f, g;
+    EXPECT_CALL(*invoker_, invoke(_))
+        .WillOnce(SaveArg<0>(&f))
+        .WillOnce(SaveArg<0>(&g));
+
+    poller_->watch(move(w0));
+    poller_->watch(move(w1));
+
+    f(); // Poll
+    g(); // Dispatch w0 and w1
+
+    EXPECT_EQ(t0, t1);
+}
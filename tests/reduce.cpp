@@ -0,0 +1,143 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/reduce.h>
+#include <thousandeyes/futures/util.h>
+
+using std::future;
+using std::future_status;
+using std::make_shared;
+using std::promise;
+using std::runtime_error;
+using std::string;
+using std::vector;
+using std::chrono::milliseconds;
+
+using thousandeyes::futures::DefaultExecutor;
+using thousandeyes::futures::ReduceOrder;
+using thousandeyes::futures::WaitableTimedOutException;
+using thousandeyes::futures::fromException;
+using thousandeyes::futures::fromValue;
+using thousandeyes::futures::reduce;
+
+using ::testing::Test;
+
+class ReduceTest : public Test {
+protected:
+    ReduceTest() :
+        executor_(make_shared<DefaultExecutor>(milliseconds(10)))
+    {}
+
+    ~ReduceTest()
+    {
+        executor_->stop();
+    }
+
+    std::shared_ptr<DefaultExecutor> executor_;
+};
+
+TEST_F(ReduceTest, Sum)
+{
+    vector<future<int>> futures;
+    for (int i = 0; i < 1821; ++i) {
+        futures.push_back(fromValue(i));
+    }
+
+    auto f = reduce(executor_, move(futures), 0, [](int sum, int value) {
+        return sum + value;
+    });
+
+    EXPECT_EQ(1821 * 1820 / 2, f.get());
+}
+
+TEST_F(ReduceTest, FoldInCompletionOrder)
+{
+    vector<promise<string>> promises(3);
+    vector<future<string>> futures;
+    for (auto& p: promises) {
+        futures.push_back(p.get_future());
+    }
+
+    auto f = reduce(executor_, move(futures), string(), [](string acc, string value) {
+        return acc + value;
+    });
+
+    promises[2].set_value("c");
+    std::this_thread::sleep_for(milliseconds(30));
+    promises[0].set_value("a");
+    std::this_thread::sleep_for(milliseconds(30));
+    promises[1].set_value("b");
+
+    EXPECT_EQ("cab", f.get());
+}
+
+TEST_F(ReduceTest, FoldInInputOrder)
+{
+    vector<promise<string>> promises(3);
+    vector<future<string>> futures;
+    for (auto& p: promises) {
+        futures.push_back(p.get_future());
+    }
+
+    auto f = reduce(executor_, ReduceOrder::Input, move(futures), string(), [](string acc, string value) {
+        return acc + value;
+    });
+
+    promises[2].set_value("c");
+    std::this_thread::sleep_for(milliseconds(30));
+    promises[0].set_value("a");
+    std::this_thread::sleep_for(milliseconds(30));
+    promises[1].set_value("b");
+
+    EXPECT_EQ("abc", f.get());
+}
+
+TEST_F(ReduceTest, FailOnFirstException)
+{
+    promise<int> pending;
+
+    vector<future<int>> futures;
+    futures.push_back(pending.get_future());
+    futures.push_back(fromException<int>(std::make_exception_ptr(runtime_error("failed"))));
+
+    auto f = reduce(executor_, move(futures), 0, [](int sum, int value) {
+        return sum + value;
+    });
+
+    // Ready without waiting for the pending future
+    EXPECT_EQ(future_status::ready, f.wait_for(milliseconds(1000)));
+    EXPECT_THROW(f.get(), runtime_error);
+}
+
+TEST_F(ReduceTest, TimeOut)
+{
+    promise<int> pending;
+
+    vector<future<int>> futures;
+    futures.push_back(pending.get_future());
+
+    auto f = reduce(executor_, milliseconds(20), ReduceOrder::Input, move(futures), 0, [](int sum, int value) {
+        return sum + value;
+    });
+
+    EXPECT_THROW(f.get(), WaitableTimedOutException);
+}
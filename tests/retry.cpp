@@ -0,0 +1,212 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/retry.h>
+#include <thousandeyes/futures/util.h>
+
+using std::atomic;
+using std::future;
+using std::future_status;
+using std::make_shared;
+using std::promise;
+using std::runtime_error;
+using std::chrono::hours;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+using thousandeyes::futures::CancellationSource;
+using thousandeyes::futures::DefaultExecutor;
+using thousandeyes::futures::RetryPolicy;
+using thousandeyes::futures::WaitableCancelledException;
+using thousandeyes::futures::WaitableTimedOutException;
+using thousandeyes::futures::fromException;
+using thousandeyes::futures::fromValue;
+using thousandeyes::futures::retry;
+
+using ::testing::Test;
+
+class RetryTest : public Test {
+protected:
+    RetryTest() :
+        executor_(make_shared<DefaultExecutor>(milliseconds(10)))
+    {}
+
+    ~RetryTest()
+    {
+        executor_->stop();
+    }
+
+    std::shared_ptr<DefaultExecutor> executor_;
+};
+
+TEST_F(RetryTest, SucceedAfterFailedAttempts)
+{
+    RetryPolicy policy;
+    policy.maxAttempts = 5;
+    policy.initialDelay = milliseconds(10);
+
+    atomic<int> attempts{ 0 };
+
+    auto t0 = steady_clock::now();
+
+    auto f = retry(executor_, policy, [&attempts]() {
+        if (++attempts < 3) {
+            return fromException<int>(std::make_exception_ptr(runtime_error("failed")));
+        }
+        return fromValue(1821);
+    });
+
+    EXPECT_EQ(1821, f.get());
+    EXPECT_EQ(3, attempts);
+
+    // Backed off 10ms and then 20ms
+    EXPECT_GE(steady_clock::now() - t0, milliseconds(30));
+}
+
+TEST_F(RetryTest, FailAfterMaxAttempts)
+{
+    RetryPolicy policy;
+    policy.maxAttempts = 3;
+    policy.initialDelay = milliseconds(1);
+
+    atomic<int> attempts{ 0 };
+
+    auto f = retry(executor_, policy, [&attempts]() -> future<void> {
+        throw runtime_error("failed " + std::to_string(++attempts));
+    });
+
+    try {
+        f.get();
+        FAIL();
+    }
+    catch (const runtime_error& e) {
+        EXPECT_STREQ("failed 3", e.what());
+    }
+
+    EXPECT_EQ(3, attempts);
+}
+
+TEST_F(RetryTest, FailInvalidFutures)
+{
+    RetryPolicy policy;
+    policy.maxAttempts = 3;
+    policy.initialDelay = milliseconds(1);
+
+    atomic<int> attempts{ 0 };
+
+    auto f = retry(executor_, policy, [&attempts]() {
+        ++attempts;
+        return future<int>();
+    });
+
+    ASSERT_EQ(future_status::ready, f.wait_for(milliseconds(5000)));
+
+    try {
+        f.get();
+        FAIL();
+    }
+    catch (const std::future_error& e) {
+        EXPECT_EQ(std::future_errc::no_state, e.code());
+    }
+
+    EXPECT_EQ(3, attempts);
+}
+
+TEST_F(RetryTest, StopRetryingAtTimeLimit)
+{
+    RetryPolicy policy;
+    policy.maxAttempts = 100;
+    policy.initialDelay = milliseconds(20);
+    policy.multiplier = 1.0;
+    policy.timeLimit = milliseconds(50);
+
+    atomic<int> attempts{ 0 };
+
+    auto f = retry(executor_, policy, [&attempts]() {
+        ++attempts;
+        return fromException<int>(std::make_exception_ptr(runtime_error("failed")));
+    });
+
+    EXPECT_THROW(f.get(), runtime_error);
+    EXPECT_LE(attempts, 3);
+}
+
+TEST_F(RetryTest, TimeOutPendingAttempt)
+{
+    RetryPolicy policy;
+    policy.timeLimit = milliseconds(30);
+
+    promise<int> p;
+
+    auto f = retry(executor_, policy, [&p]() {
+        return p.get_future();
+    });
+
+    EXPECT_THROW(f.get(), WaitableTimedOutException);
+}
+
+TEST_F(RetryTest, CancelRetries)
+{
+    RetryPolicy policy;
+    policy.maxAttempts = 100;
+    policy.initialDelay = hours(1);
+
+    CancellationSource source;
+
+    auto f = retry(executor_, source.token(), policy, []() {
+        return fromException<int>(std::make_exception_ptr(runtime_error("failed")));
+    });
+
+    source.cancel();
+
+    EXPECT_EQ(future_status::ready, f.wait_for(milliseconds(1000)));
+    EXPECT_THROW(f.get(), WaitableCancelledException);
+}
+
+TEST(RetryPolicyTest, Delay)
+{
+    RetryPolicy policy;
+    policy.initialDelay = milliseconds(10);
+    policy.multiplier = 3.0;
+    policy.maxDelay = milliseconds(100);
+
+    EXPECT_EQ(milliseconds(10), policy.delay(1));
+    EXPECT_EQ(milliseconds(30), policy.delay(2));
+    EXPECT_EQ(milliseconds(90), policy.delay(3));
+    EXPECT_EQ(milliseconds(100), policy.delay(4));
+    EXPECT_EQ(milliseconds(100), policy.delay(100));
+
+    policy.jitter = 0.5;
+
+    for (int i = 0; i < 100; ++i) {
+        auto d = policy.delay(2);
+        EXPECT_GT(d, milliseconds(15));
+        EXPECT_LE(d, milliseconds(30));
+    }
+
+    // The jitter is clamped, so that delays are never negative
+    policy.jitter = 2.0;
+
+    for (int i = 0; i < 100; ++i) {
+        auto d = policy.delay(2);
+        EXPECT_GE(d, milliseconds(0));
+        EXPECT_LE(d, milliseconds(30));
+    }
+}
@@ -0,0 +1,286 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/ShardedExecutor.h>
+#include <thousandeyes/futures/Waitable.h>
+#include <thousandeyes/futures/then.h>
+#include <thousandeyes/futures/util.h>
+
+using std::future;
+using std::invalid_argument;
+using std::make_shared;
+using std::make_unique;
+using std::move;
+using std::promise;
+using std::shared_ptr;
+using std::string;
+using std::thread;
+using std::to_string;
+using std::unique_ptr;
+using std::vector;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+using std::chrono::steady_clock;
+
+using thousandeyes::futures::DefaultExecutor;
+using thousandeyes::futures::Executor;
+using thousandeyes::futures::ShardedExecutor;
+using thousandeyes::futures::ShardRouting;
+using thousandeyes::futures::Waitable;
+using thousandeyes::futures::WaitableWaitException;
+using thousandeyes::futures::fromValue;
+using thousandeyes::futures::then;
+
+using ::testing::ElementsAre;
+using ::testing::Test;
+using ::testing::_;
+
+namespace {
+
+class WaitableMock : public Waitable {
+public:
+    MOCK_METHOD1(wait, bool(const std::chrono::microseconds& timeout));
+
+    MOCK_METHOD1(dispatch, void(std::exception_ptr err));
+};
+
+class ExecutorMock : public Executor {
+public:
+    void watch(unique_ptr<Waitable> w) override
+    {
+        watchProxy(w.get());
+    }
+
+    MOCK_METHOD1(watchProxy, void(Waitable* w));
+
+    MOCK_METHOD0(stop, void());
+};
+
+using MockShardedExecutor = ShardedExecutor<ExecutorMock>;
+
+vector<shared_ptr<ExecutorMock>> makeShards(int count)
+{
+    vector<shared_ptr<ExecutorMock>> shards;
+    for (int i = 0; i < count; ++i) {
+        auto shard = make_shared<ExecutorMock>();
+        EXPECT_CALL(*shard, stop()).Times(::testing::AtLeast(1));
+        shards.push_back(move(shard));
+    }
+    return shards;
+}
+
+// Each continuation watches the next one via the executor, i.e., on the next shard
+future<int> chain(shared_ptr<Executor> executor, future<int> f, int depth)
+{
+    return then(executor, move(f), [executor, depth](future<int> f) {
+        auto value = f.get() + 1;
+        if (depth == 0) {
+            return fromValue(value);
+        }
+
+        std::this_thread::sleep_for(milliseconds(5));
+
+        return chain(executor, fromValue(value), depth - 1);
+    });
+}
+
+// Each continuation watches the next one directly via the shard of its key and
+// returns, so that only the last continuation sets the result
+void chainByKey(shared_ptr<ShardedExecutor<DefaultExecutor>> executor,
+                future<int> f,
+                int depth,
+                shared_ptr<promise<int>> result)
+{
+    then(executor->shard(depth), move(f), [executor, depth, result](future<int> f) {
+        auto value = f.get() + 1;
+        if (depth == 0) {
+            result->set_value(value);
+            return;
+        }
+
+        std::this_thread::sleep_for(milliseconds(5));
+
+        chainByKey(executor, fromValue(value), depth - 1, result);
+    });
+}
+
+} // namespace
+
+TEST(ShardedExecutorTest, RequiresAtLeastOneShard)
+{
+    EXPECT_THROW(MockShardedExecutor(vector<shared_ptr<ExecutorMock>>{}),
+                 invalid_argument);
+}
+
+TEST(ShardedExecutorTest, RoundRobinRouting)
+{
+    auto shards = makeShards(3);
+
+    EXPECT_CALL(*shards[0], watchProxy(_)).Times(2);
+    EXPECT_CALL(*shards[1], watchProxy(_)).Times(2);
+    EXPECT_CALL(*shards[2], watchProxy(_)).Times(1);
+
+    MockShardedExecutor executor(shards, ShardRouting::RoundRobin);
+
+    for (int i = 0; i < 5; ++i) {
+        executor.watch(make_unique<WaitableMock>());
+    }
+
+    EXPECT_THAT(executor.watchCounts(), ElementsAre(2U, 2U, 1U));
+}
+
+TEST(ShardedExecutorTest, ThreadIdRouting)
+{
+    auto shards = makeShards(4);
+
+    MockShardedExecutor executor(shards, ShardRouting::ThreadId);
+
+    for (auto& shard: shards) {
+        EXPECT_CALL(*shard, watchProxy(_)).Times(::testing::AnyNumber());
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        executor.watch(make_unique<WaitableMock>());
+    }
+
+    thread([&executor]() {
+        for (int i = 0; i < 10; ++i) {
+            executor.watch(make_unique<WaitableMock>());
+        }
+    }).join();
+
+    // All the watches of a thread end up in the same shard
+    for (auto count: executor.watchCounts()) {
+        EXPECT_TRUE(count == 0U || count == 10U || count == 20U);
+    }
+}
+
+TEST(ShardedExecutorTest, KeyRouting)
+{
+    auto shards = makeShards(3);
+
+    MockShardedExecutor executor(shards);
+
+    EXPECT_EQ(3U, executor.shardCount());
+    EXPECT_EQ(shards[0], executor.shard(0));
+    EXPECT_EQ(shards[1], executor.shard(1));
+    EXPECT_EQ(shards[1], executor.shard(1822));
+    EXPECT_EQ(shards[2], executor.shard(1823));
+}
+
+TEST(ShardedExecutorTest, StopStopsAllShards)
+{
+    auto shards = makeShards(3);
+
+    MockShardedExecutor executor(shards);
+
+    executor.stop();
+}
+
+TEST(ShardedExecutorTest, ThenWithDefaultExecutorShards)
+{
+    auto executor = make_shared<ShardedExecutor<DefaultExecutor>>(4, milliseconds(10));
+
+    vector<promise<int>> promises(100);
+    vector<future<string>> results;
+    for (auto& p: promises) {
+        results.push_back(then(executor, p.get_future(), [](future<int> f) {
+            return to_string(f.get());
+        }));
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        promises[i].set_value(i);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(to_string(i), results[i].get());
+    }
+
+    EXPECT_THAT(executor->watchCounts(), ElementsAre(25U, 25U, 25U, 25U));
+
+    executor->stop();
+}
+
+TEST(ShardedExecutorTest, DrainChainsContinuationsAcrossShards)
+{
+    auto executor = make_shared<ShardedExecutor<DefaultExecutor>>(4, milliseconds(10));
+
+    promise<int> p;
+    auto f = chain(executor, p.get_future(), 10);
+
+    auto drained = std::async(std::launch::async, [executor]() {
+        return executor->drain(steady_clock::now() + seconds(10));
+    });
+
+    std::this_thread::sleep_for(milliseconds(50));
+
+    // Watched from outside the executor, so it is rejected while draining
+    auto g = then(executor, fromValue(1822), [](future<int> f) {
+        return to_string(f.get());
+    });
+
+    EXPECT_THROW(g.get(), WaitableWaitException);
+
+    p.set_value(0);
+
+    EXPECT_EQ(11, f.get());
+    EXPECT_TRUE(drained.get());
+}
+
+TEST(ShardedExecutorTest, DrainChainsContinuationsAcrossKeyShards)
+{
+    vector<shared_ptr<DefaultExecutor>> shards;
+    for (int i = 0; i < 4; ++i) {
+        shards.push_back(make_shared<DefaultExecutor>(milliseconds(10)));
+    }
+
+    auto executor = make_shared<ShardedExecutor<DefaultExecutor>>(shards);
+
+    promise<int> p;
+    auto result = make_shared<promise<int>>();
+    auto f = result->get_future();
+
+    chainByKey(executor, p.get_future(), 10, result);
+
+    auto drained = std::async(std::launch::async, [executor]() {
+        return executor->drain(steady_clock::now() + seconds(10));
+    });
+
+    std::this_thread::sleep_for(milliseconds(50));
+
+    // Watched from outside the executor, so it is rejected while draining
+    auto g = then(executor->shard(0), fromValue(1822), [](future<int> f) {
+        return to_string(f.get());
+    });
+
+    EXPECT_THROW(g.get(), WaitableWaitException);
+
+    p.set_value(0);
+
+    ASSERT_EQ(std::future_status::ready, f.wait_for(seconds(10)));
+    EXPECT_EQ(11, f.get());
+    EXPECT_TRUE(drained.get());
+
+    // None of the waitables was routed via the watch() of the executor
+    EXPECT_THAT(executor->watchCounts(), ElementsAre(0U, 0U, 0U, 0U));
+}
@@ -14,6 +14,7 @@
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -35,12 +36,17 @@ using std::chrono::minutes;
 using std::chrono::seconds;
 using std::chrono::milliseconds;
 using std::chrono::microseconds;
+using std::chrono::nanoseconds;
 using std::chrono::duration_cast;
 using std::this_thread::sleep_for;
 
+using thousandeyes::futures::CancellationSource;
 using thousandeyes::futures::Waitable;
+using thousandeyes::futures::WaitableCancelledException;
 using thousandeyes::futures::WaitableTimedOutException;
+using thousandeyes::futures::StaticTimedWaitable;
 using thousandeyes::futures::TimedWaitable;
+using thousandeyes::futures::toTimestamp;
 
 using ::testing::Return;
 using ::testing::Test;
@@ -51,7 +57,7 @@ namespace {
 
 class TimedWaitableMock : public TimedWaitable {
 public:
-    explicit TimedWaitableMock(microseconds timeout) :
+    explicit TimedWaitableMock(nanoseconds timeout) :
         TimedWaitable(move(timeout))
     {}
 
@@ -60,6 +66,25 @@ public:
     MOCK_METHOD1(dispatch, void(std::exception_ptr err));
 };
 
+class StaticTimedWaitableStub final : public StaticTimedWaitable<StaticTimedWaitableStub> {
+public:
+    explicit StaticTimedWaitableStub(nanoseconds timeout) :
+        StaticTimedWaitable(move(timeout))
+    {}
+
+    bool timedWait(const std::chrono::microseconds& timeout)
+    {
+        timeouts.push_back(timeout);
+        return isReady;
+    }
+
+    void dispatch(std::exception_ptr /* err */) override
+    {}
+
+    std::vector<microseconds> timeouts;
+    bool isReady{ false };
+};
+
 } // namespace
 
 TEST(TimedWaitableTest, Ready)
@@ -133,3 +158,103 @@ TEST(TimedWaitableTest, ExpiredAndReady)
 
     EXPECT_EQ(true, waitable->wait(milliseconds(10)));
 }
+
+TEST(TimedWaitableTest, Cancelled)
+{
+    auto waitable = make_unique<TimedWaitableMock>(hours(1823));
+
+    CancellationSource source;
+    waitable->setCancellationToken(source.token());
+
+    EXPECT_CALL(*waitable, timedWait(microseconds(10000)))
+        .WillOnce(Return(false));
+
+    EXPECT_EQ(false, waitable->wait(milliseconds(10)));
+
+    source.cancel();
+
+    EXPECT_TRUE(waitable->cancelled());
+    EXPECT_THROW(waitable->wait(milliseconds(10)),
+                 WaitableCancelledException);
+}
+
+TEST(TimedWaitableTest, ExpiredAtGivenTimestamp)
+{
+    auto waitable = make_unique<TimedWaitableMock>(milliseconds(30));
+
+    auto now = toTimestamp(std::chrono::steady_clock::now());
+
+    EXPECT_CALL(*waitable, timedWait(microseconds(10000)))
+        .WillOnce(Return(false));
+
+    EXPECT_CALL(*waitable, timedWait(microseconds(0)))
+        .WillOnce(Return(false));
+
+    EXPECT_EQ(false, waitable->wait(milliseconds(10), now));
+
+    // Only the given timestamp is taken into account, not the clock
+    EXPECT_THROW(waitable->wait(milliseconds(10), now + milliseconds(40)),
+                 WaitableTimedOutException);
+}
+
+TEST(TimedWaitableTest, WaitNoLongerThanDeadline)
+{
+    auto waitable = make_unique<TimedWaitableMock>(milliseconds(30));
+
+    auto deadline = waitable->deadline();
+
+    EXPECT_CALL(*waitable, timedWait(microseconds(2500)))
+        .WillOnce(Return(false));
+
+    // The time left is rounded up to the next microsecond
+    EXPECT_CALL(*waitable, timedWait(microseconds(2)))
+        .WillOnce(Return(false));
+
+    EXPECT_EQ(false, waitable->wait(milliseconds(10), deadline - microseconds(2500)));
+    EXPECT_EQ(false, waitable->wait(milliseconds(10), deadline - nanoseconds(1500)));
+}
+
+TEST(TimedWaitableTest, ExpiredWithSubMillisecondTimeout)
+{
+    auto now = toTimestamp(std::chrono::steady_clock::now());
+
+    auto waitable = make_unique<TimedWaitableMock>(microseconds(500));
+
+    // The deadline is not rounded to milliseconds
+    EXPECT_GE(waitable->deadline() - now, microseconds(500));
+    EXPECT_LT(waitable->deadline() - now, milliseconds(100));
+
+    // Waits for the nanosecond left, rounded up, not for the whole quantum
+    EXPECT_CALL(*waitable, timedWait(microseconds(1)))
+        .WillOnce(Return(false));
+
+    EXPECT_CALL(*waitable, timedWait(microseconds(0)))
+        .WillOnce(Return(false));
+
+    EXPECT_EQ(false, waitable->wait(milliseconds(10), waitable->deadline() - nanoseconds(1)));
+
+    EXPECT_THROW(waitable->wait(milliseconds(10), waitable->deadline()),
+                 WaitableTimedOutException);
+}
+
+TEST(TimedWaitableTest, StaticallyDispatchedTimedWait)
+{
+    auto stub = make_unique<StaticTimedWaitableStub>(milliseconds(30));
+    Waitable& waitable = *stub;
+
+    auto now = toTimestamp(std::chrono::steady_clock::now());
+
+    EXPECT_EQ(false, waitable.wait(milliseconds(10), now));
+
+    stub->isReady = true;
+    EXPECT_EQ(true, waitable.wait(milliseconds(10), now));
+
+    stub->isReady = false;
+    EXPECT_THROW(waitable.wait(milliseconds(10), now + milliseconds(40)),
+                 WaitableTimedOutException);
+
+    ASSERT_EQ(3, stub->timeouts.size());
+    EXPECT_EQ(microseconds(10000), stub->timeouts[0]);
+    EXPECT_EQ(microseconds(10000), stub->timeouts[1]);
+    EXPECT_EQ(microseconds(0), stub->timeouts[2]);
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/all.h>
+#include <thousandeyes/futures/then.h>
+#include <thousandeyes/futures/timer.h>
+
+using std::future;
+using std::future_status;
+using std::make_shared;
+using std::vector;
+using std::chrono::hours;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+using thousandeyes::futures::CancellationSource;
+using thousandeyes::futures::DefaultExecutor;
+using thousandeyes::futures::WaitableCancelledException;
+using thousandeyes::futures::after;
+using thousandeyes::futures::all;
+using thousandeyes::futures::at;
+using thousandeyes::futures::then;
+
+using ::testing::Test;
+
+class TimerTest : public Test {
+protected:
+    TimerTest() :
+        executor_(make_shared<DefaultExecutor>(milliseconds(10)))
+    {}
+
+    ~TimerTest()
+    {
+        executor_->stop();
+    }
+
+    std::shared_ptr<DefaultExecutor> executor_;
+};
+
+TEST_F(TimerTest, AfterDelay)
+{
+    auto t0 = steady_clock::now();
+
+    auto f = after(executor_, milliseconds(30));
+
+    f.get();
+
+    EXPECT_GE(steady_clock::now() - t0, milliseconds(30));
+}
+
+TEST_F(TimerTest, AtTimePointInThePast)
+{
+    auto f = at(executor_, steady_clock::now() - hours(1));
+
+    EXPECT_EQ(future_status::ready, f.wait_for(milliseconds(1000)));
+    f.get();
+}
+
+TEST_F(TimerTest, ChainTimers)
+{
+    auto t0 = steady_clock::now();
+
+    vector<future<void>> timers;
+    for (int i = 0; i < 1000; ++i) {
+        timers.push_back(after(executor_, milliseconds(20 + i % 20)));
+    }
+
+    auto f = then(executor_, all(executor_, std::move(timers)), [](future<vector<future<void>>> f) {
+        return static_cast<int>(f.get().size());
+    });
+
+    EXPECT_EQ(1000, f.get());
+    EXPECT_GE(steady_clock::now() - t0, milliseconds(39));
+}
+
+TEST_F(TimerTest, CancelTimer)
+{
+    CancellationSource source;
+
+    auto f = after(executor_, source.token(), hours(1));
+
+    source.cancel();
+
+    EXPECT_EQ(future_status::ready, f.wait_for(milliseconds(1000)));
+    EXPECT_THROW(f.get(), WaitableCancelledException);
+}
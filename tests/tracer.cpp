@@ -0,0 +1,250 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#define THOUSANDEYES_FUTURES_TRACING
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thousandeyes/futures/PollingExecutor.h>
+#include <thousandeyes/futures/Tracer.h>
+#include <thousandeyes/futures/Waitable.h>
+
+using std::function;
+using std::make_shared;
+using std::make_unique;
+using std::move;
+using std::ostringstream;
+using std::shared_ptr;
+using std::string;
+using std::vector;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+using thousandeyes::futures::PollingExecutor;
+using thousandeyes::futures::TraceEvent;
+using thousandeyes::futures::TraceRecord;
+using thousandeyes::futures::Tracer;
+using thousandeyes::futures::Waitable;
+
+using ::testing::HasSubstr;
+using ::testing::IsNull;
+using ::testing::Return;
+using ::testing::SaveArg;
+using ::testing::Test;
+using ::testing::_;
+
+namespace {
+
+class WaitableMock : public Waitable {
+public:
+    MOCK_METHOD1(wait, bool(const std::chrono::microseconds& timeout));
+
+    MOCK_METHOD1(dispatch, void(std::exception_ptr err));
+};
+
+class Invoker {
+public:
+    MOCK_METHOD1(invoke, void(function<void()> f));
+};
+
+class DispatcherFunctor {
+public:
+    explicit DispatcherFunctor(shared_ptr<Invoker> invoker) :
+        invoker_(move(invoker))
+    {}
+
+    void operator()(function<void()> f)
+    {
+        invoker_->invoke(move(f));
+    }
+
+private:
+    shared_ptr<Invoker> invoker_;
+};
+
+class Executor : public PollingExecutor<DispatcherFunctor, DispatcherFunctor> {
+public:
+    Executor(milliseconds q, shared_ptr<Invoker> d) :
+        PollingExecutor(move(q), DispatcherFunctor(d), DispatcherFunctor(d))
+    {}
+};
+
+vector<TraceEvent> eventsOf(const Tracer& tracer, const void* id)
+{
+    vector<TraceEvent> result;
+    for (const TraceRecord& r: tracer.records()) {
+        if (r.id == id) {
+            result.push_back(r.event);
+        }
+    }
+
+    return result;
+}
+
+std::size_t count(const string& s, const string& what)
+{
+    std::size_t result = 0;
+    for (auto i = s.find(what); i != string::npos; i = s.find(what, i + 1)) {
+        ++result;
+    }
+
+    return result;
+}
+
+} // namespace
+
+class TracerTest : public Test {
+public:
+    TracerTest() :
+        invoker_(make_shared<Invoker>()),
+        poller_(make_shared<Executor>(milliseconds(10), invoker_)),
+        tracer_(make_shared<Tracer>())
+    {
+        poller_->setTracer(tracer_);
+    }
+
+protected:
+    shared_ptr<Invoker> invoker_;
+    shared_ptr<Executor> poller_;
+    shared_ptr<Tracer> tracer_;
+};
+
+TEST_F(TracerTest, KeepLatestRecords)
+{
+    Tracer tracer(4);
+
+    int ids[6];
+    for (int& id: ids) {
+        tracer.record(TraceEvent::Watched, &id);
+    }
+
+    auto records = tracer.records();
+
+    ASSERT_EQ(4, records.size());
+    EXPECT_EQ(2, tracer.dropped());
+
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(&ids[i + 2], records[i].id);
+        EXPECT_EQ(TraceEvent::Watched, records[i].event);
+    }
+
+    for (std::size_t i = 1; i < records.size(); ++i) {
+        EXPECT_LE(records[i - 1].timestamp, records[i].timestamp);
+    }
+
+    tracer.clear();
+
+    EXPECT_TRUE(tracer.records().empty());
+    EXPECT_EQ(0, tracer.dropped());
+}
+
+TEST_F(TracerTest, TraceWaitableLifecycle)
+{
+    auto waitable = make_unique<WaitableMock>();
+    const void* id = waitable.get();
+
+    EXPECT_CALL(*waitable, wait(microseconds(10000)))
+        .WillOnce(Return(false))
+        .WillOnce(Return(true));
+
+    EXPECT_CALL(*waitable, dispatch(IsNull()))
+        .Times(1);
+
+    function<void()> f, g;
+    EXPECT_CALL(*invoker_, invoke(_))
+        .WillOnce(SaveArg<0>(&f))
+        .WillOnce(SaveArg<0>(&g));
+
+    poller_->watch(move(waitable));
+
+    f(); // Poll
+
+    EXPECT_EQ(vector<TraceEvent>({
+        TraceEvent::Watched,
+        TraceEvent::PollBegin,
+        TraceEvent::PollEnd,
+        TraceEvent::PollBegin,
+        TraceEvent::PollEnd,
+        TraceEvent::Ready
+    }), eventsOf(*tracer_, id));
+
+    g(); // Dispatch
+
+    auto events = eventsOf(*tracer_, id);
+
+    ASSERT_EQ(8, events.size());
+    EXPECT_EQ(TraceEvent::DispatchBegin, events[6]);
+    EXPECT_EQ(TraceEvent::DispatchEnd, events[7]);
+}
+
+TEST_F(TracerTest, StopTracing)
+{
+    poller_->setTracer(nullptr);
+
+    auto waitable = make_unique<WaitableMock>();
+
+    EXPECT_CALL(*waitable, wait(microseconds(10000)))
+        .WillOnce(Return(true));
+
+    EXPECT_CALL(*waitable, dispatch(IsNull()))
+        .Times(1);
+
+    function<void()> f, g;
+    EXPECT_CALL(*invoker_, invoke(_))
+        .WillOnce(SaveArg<0>(&f))
+        .WillOnce(SaveArg<0>(&g));
+
+    poller_->watch(move(waitable));
+
+    f(); // Poll
+    g(); // Dispatch
+
+    EXPECT_TRUE(tracer_->records().empty());
+}
+
+TEST_F(TracerTest, WriteChromeTrace)
+{
+    int id = 0;
+
+    tracer_->record(TraceEvent::Watched, &id);
+    tracer_->record(TraceEvent::PollBegin, &id);
+    tracer_->record(TraceEvent::PollEnd, &id);
+    tracer_->record(TraceEvent::Ready, &id);
+    tracer_->record(TraceEvent::DispatchBegin, &id);
+    tracer_->record(TraceEvent::DispatchEnd, &id);
+
+    ostringstream os;
+    tracer_->writeChromeTrace(os);
+
+    auto trace = os.str();
+
+    EXPECT_EQ(0, trace.find("{\"traceEvents\":["));
+    EXPECT_THAT(trace, HasSubstr("\"name\":\"pending\""));
+    EXPECT_THAT(trace, HasSubstr("\"name\":\"queued\""));
+    EXPECT_THAT(trace, HasSubstr("\"name\":\"dispatch\""));
+    EXPECT_THAT(trace, HasSubstr("\"name\":\"poll\""));
+
+    // All the spans are closed
+    EXPECT_EQ(3, count(trace, "\"ph\":\"b\""));
+    EXPECT_EQ(3, count(trace, "\"ph\":\"e\""));
+    EXPECT_EQ(2, count(trace, "\"ph\":\"B\""));
+    EXPECT_EQ(2, count(trace, "\"ph\":\"E\""));
+
+    EXPECT_EQ(count(trace, "{"), count(trace, "}"));
+    EXPECT_EQ(10 + 1, count(trace, "{")); // The events and the enclosing object
+}
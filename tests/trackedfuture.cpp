@@ -0,0 +1,140 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thousandeyes/futures/DefaultExecutor.h>
+#include <thousandeyes/futures/TrackedFuture.h>
+
+using std::atomic;
+using std::future;
+using std::future_status;
+using std::make_shared;
+using std::promise;
+using std::string;
+using std::to_string;
+using std::chrono::hours;
+using std::chrono::milliseconds;
+using std::this_thread::sleep_for;
+
+using thousandeyes::futures::CancellationSource;
+using thousandeyes::futures::Default;
+using thousandeyes::futures::DefaultExecutor;
+using thousandeyes::futures::Executor;
+using thousandeyes::futures::TrackedFuture;
+using thousandeyes::futures::WaitableCancelledException;
+using thousandeyes::futures::thenTracked;
+
+using ::testing::Test;
+
+class TrackedFutureTest : public Test {
+protected:
+    TrackedFutureTest() :
+        executor_(make_shared<DefaultExecutor>(milliseconds(10)))
+    {}
+
+    ~TrackedFutureTest()
+    {
+        executor_->stop();
+    }
+
+    std::shared_ptr<DefaultExecutor> executor_;
+};
+
+TEST_F(TrackedFutureTest, GetValue)
+{
+    promise<int> p;
+
+    auto f = thenTracked(executor_, p.get_future(), [](future<int> f) {
+        return to_string(f.get());
+    });
+
+    p.set_value(1821);
+
+    EXPECT_EQ("1821", f.get());
+}
+
+TEST_F(TrackedFutureTest, DiscardAbandonedContinuation)
+{
+    promise<int> p;
+    atomic<bool> invoked{ false };
+
+    {
+        auto f = thenTracked(executor_, p.get_future(), [&invoked](future<int> f) {
+            invoked = true;
+            return f.get();
+        });
+    }
+
+    p.set_value(1822);
+    sleep_for(milliseconds(50));
+
+    EXPECT_FALSE(invoked);
+}
+
+TEST_F(TrackedFutureTest, ReleasedFutureIsNotTracked)
+{
+    promise<int> p;
+
+    future<string> f;
+    {
+        auto tracked = thenTracked(executor_, hours(1), p.get_future(), [](future<int> f) {
+            return to_string(f.get());
+        });
+
+        f = tracked.release();
+    }
+
+    p.set_value(1823);
+
+    EXPECT_EQ("1823", f.get());
+}
+
+TEST_F(TrackedFutureTest, CancelWholeChain)
+{
+    promise<int> p;
+
+    auto f0 = thenTracked(executor_, p.get_future(), [](future<int> f) {
+        return f.get() + 1;
+    });
+
+    auto f1 = thenTracked(executor_, std::move(f0), [](future<int> f) {
+        return to_string(f.get());
+    });
+
+    f1.cancel();
+
+    EXPECT_THROW(f1.get(), WaitableCancelledException);
+}
+
+TEST_F(TrackedFutureTest, DefaultExecutor)
+{
+    Default<Executor>::Setter execSetter(executor_);
+
+    promise<void> p;
+
+    auto f = thenTracked(p.get_future(), [](future<void> f) {
+        f.get();
+        return string("1824");
+    });
+
+    p.set_value();
+
+    EXPECT_EQ(future_status::ready, f.wait_for(hours(1)));
+    EXPECT_EQ("1824", f.get());
+}
@@ -28,6 +28,8 @@ using std::unique_ptr;
 using std::weak_ptr;
 using std::string;
 using std::chrono::milliseconds;
+using std::chrono::microseconds;
+using std::chrono::nanoseconds;
 
 using thousandeyes::futures::Waitable;
 
@@ -41,8 +43,8 @@ namespace {
 
 class WaitableMock : public Waitable {
 public:
-    WaitableMock(milliseconds epochDeadline) :
-        Waitable(move(epochDeadline))
+    WaitableMock(nanoseconds deadline) :
+        Waitable(move(deadline))
     {}
 
     MOCK_METHOD1(wait, bool(const std::chrono::microseconds& timeout));
@@ -84,3 +86,23 @@ TEST(WaitableTest, Expired)
     EXPECT_TRUE(w.expired(milliseconds(1822)));
     EXPECT_TRUE(w.expired(milliseconds(3642)));
 }
+
+TEST(WaitableTest, ExpiredWithNanosecondResolution)
+{
+    WaitableMock w{ microseconds(1821) };
+
+    EXPECT_EQ(microseconds(1821), w.deadline());
+    EXPECT_EQ(nanoseconds(1), w.timeout(nanoseconds(1820999)));
+    EXPECT_FALSE(w.expired(nanoseconds(1820999)));
+    EXPECT_TRUE(w.expired(nanoseconds(1821000)));
+}
+
+TEST(WaitableTest, WaitWithTimestampFallsBackToWait)
+{
+    unique_ptr<Waitable> w = make_unique<WaitableMock>(milliseconds(1821));
+
+    EXPECT_CALL(static_cast<WaitableMock&>(*w), wait(microseconds(10)))
+        .WillOnce(Return(true));
+
+    EXPECT_TRUE(w->wait(microseconds(10), milliseconds(1822)));
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2019 ThousandEyes, Inc.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ *
+ * @author Giannis Georgalis, https://github.com/ggeorgalis
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thousandeyes/futures/Waitable.h>
+#include <thousandeyes/futures/detail/WaitableQueue.h>
+#include <thousandeyes/futures/detail/deadlines.h>
+
+using std::make_unique;
+using std::numeric_limits;
+using std::vector;
+using std::chrono::microseconds;
+using std::chrono::nanoseconds;
+
+using thousandeyes::futures::Waitable;
+using thousandeyes::futures::detail::WaitableQueue;
+using thousandeyes::futures::detail::findExpired;
+using thousandeyes::futures::detail::findExpiredScalar;
+using thousandeyes::futures::detail::maskWords;
+
+namespace {
+
+class WaitableStub : public Waitable {
+public:
+    explicit WaitableStub(int id) :
+        Waitable(nanoseconds(id)),
+        id(id)
+    {}
+
+    bool wait(const microseconds& /* q */) override
+    {
+        return false;
+    }
+
+    void dispatch(std::exception_ptr /* err */) override
+    {}
+
+    const int id;
+};
+
+} // namespace
+
+TEST(WaitableQueueTest, FirstInFirstOut)
+{
+    WaitableQueue queue;
+    EXPECT_TRUE(queue.empty());
+
+    int next = 0;
+    int expected = 0;
+
+    // Interleaves pushes and pops, so that the ring buffer wraps around and grows
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 100 * round + 50; ++i) {
+            queue.push(make_unique<WaitableStub>(next++));
+        }
+
+        for (int i = 0; i < 30; ++i) {
+            auto e = queue.pop();
+            EXPECT_EQ(expected++, static_cast<WaitableStub&>(*e.w).id);
+        }
+    }
+
+    EXPECT_EQ(static_cast<std::size_t>(next - expected), queue.size());
+
+    while (!queue.empty()) {
+        auto e = queue.pop();
+        EXPECT_EQ(expected++, static_cast<WaitableStub&>(*e.w).id);
+    }
+
+    EXPECT_EQ(next, expected);
+}
+
+TEST(WaitableQueueTest, CacheDeadline)
+{
+    WaitableQueue queue;
+
+    queue.push(make_unique<WaitableStub>(1821));
+
+    auto e = queue.pop();
+
+    EXPECT_EQ(nanoseconds(1821), e.deadline);
+
+    // Entries are pushed back without querying the waitable again
+    e.deadline = nanoseconds(1822);
+    queue.push(std::move(e));
+
+    e = queue.pop();
+
+    EXPECT_EQ(nanoseconds(1822), e.deadline);
+    EXPECT_EQ(1821, static_cast<WaitableStub&>(*e.w).id);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(WaitableQueueTest, TakeExpired)
+{
+    WaitableQueue queue;
+
+    // Wraps the ring buffer around, so that the scan crosses its end
+    for (int i = 0; i < 40; ++i) {
+        queue.push(make_unique<WaitableStub>(1000));
+    }
+
+    for (int i = 0; i < 40; ++i) {
+        queue.pop();
+    }
+
+    // Even ids expire at 100, odd ones never do and 0 is unset
+    for (int i = 0; i < 50; ++i) {
+        queue.push(make_unique<WaitableStub>(i % 2 == 0 ? i : 1000 + i));
+    }
+
+    vector<WaitableQueue::Entry> expired;
+
+    EXPECT_EQ(24, queue.takeExpired(nanoseconds(48), expired));
+    EXPECT_EQ(0, queue.takeExpired(nanoseconds(48), expired));
+    ASSERT_EQ(24, expired.size());
+
+    for (int i = 0; i < 24; ++i) {
+        EXPECT_EQ(2 * (i + 1), static_cast<WaitableStub&>(*expired[i].w).id);
+    }
+
+    // The rest keep their order
+    ASSERT_EQ(26, queue.size());
+
+    EXPECT_EQ(0, static_cast<WaitableStub&>(*queue.pop().w).id);
+    for (int i = 0; i < 25; ++i) {
+        EXPECT_EQ(1000 + 2 * i + 1, static_cast<WaitableStub&>(*queue.pop().w).id);
+    }
+}
+
+TEST(WaitableQueueTest, FindExpiredMatchesScalar)
+{
+    std::mt19937_64 random(1821);
+
+    for (std::size_t count: { 0, 1, 3, 4, 63, 64, 65, 1000 }) {
+        vector<std::int64_t> deadlines(count);
+        for (auto& d: deadlines) {
+            d = static_cast<std::int64_t>(random() % 2000) - 500;
+        }
+
+        if (count > 3) {
+            deadlines[0] = numeric_limits<std::int64_t>::min();
+            deadlines[1] = numeric_limits<std::int64_t>::max();
+            deadlines[2] = 0;
+            deadlines[3] = 700;
+        }
+
+        for (std::int64_t now: { std::int64_t(-1), std::int64_t(0), std::int64_t(700) }) {
+            vector<std::uint64_t> expected(maskWords(count));
+            vector<std::uint64_t> actual(maskWords(count));
+
+            auto n = findExpiredScalar(deadlines.data(), count, now, expected.data());
+
+            EXPECT_EQ(n, findExpired(deadlines.data(), count, now, actual.data()));
+            EXPECT_EQ(expected, actual);
+        }
+    }
+}